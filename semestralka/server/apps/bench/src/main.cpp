@@ -0,0 +1,230 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <engine/evaluation.h>
+#include <engine/mcts.h>
+#include <hive/board.h>
+#include <hive/move_list.h>
+#include <new>
+#include <random>
+#include <ranges>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <utils/print.h>
+#include <vector>
+
+namespace {
+
+std::atomic<std::size_t> allocations{0};
+
+} // namespace
+
+void *operator new(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t /*unused*/) noexcept {
+  std::free(ptr);
+}
+
+namespace {
+
+constexpr std::size_t POSITION_COUNT = 200;
+constexpr std::size_t REPETITIONS = 20;
+constexpr std::size_t MIN_PLIES = 6;
+constexpr std::size_t MAX_PLIES = 60;
+constexpr std::uint32_t SEED = 42;
+constexpr std::size_t MCTS_POSITIONS = 10;
+constexpr std::size_t MCTS_PLAYOUTS = 2'000;
+
+struct Position {
+  hive::Board board;
+  hive::Player player;
+  /// Pieces of `player` that can move, collected once up front.
+  std::vector<std::pair<hive::TilePointer, hive::Piece>> movable;
+};
+
+std::vector<std::pair<hive::TilePointer, hive::Piece>>
+movable_pieces(hive::Board &board, hive::Player player) {
+  std::vector<std::pair<hive::TilePointer, hive::Piece>> pieces;
+  for (const auto tile : board.moveable_pieces_for(player)) {
+    pieces.push_back(tile);
+  }
+  return pieces;
+}
+
+/// Positions from random games, skipping the first few plies.
+std::vector<Position> random_positions(std::size_t count) {
+  std::mt19937 rng(SEED);
+  std::vector<Position> positions;
+  positions.reserve(count);
+
+  while (positions.size() < count) {
+    hive::Board board;
+    board.apply_move(
+        hive::make_placement({.p = 0, .q = 0}, hive::PieceKind::Queen),
+        hive::Player::White
+    );
+    board.apply_move(
+        hive::make_placement({.p = 1, .q = 0}, hive::PieceKind::Queen),
+        hive::Player::Black
+    );
+
+    auto player = hive::Player::White;
+
+    for (std::size_t ply = 0; ply < MAX_PLIES && positions.size() < count;
+         ++ply) {
+      hive::MoveList moves;
+      board.moves_for_player(player, moves);
+      if (moves.empty()) {
+        break;
+      }
+
+      board.apply_move(moves[rng() % moves.size()], player);
+      player = hive::opponent(player);
+
+      if (ply >= MIN_PLIES) {
+        positions.push_back(
+            {.board = board,
+             .player = player,
+             .movable = movable_pieces(board, player)}
+        );
+      }
+    }
+  }
+
+  return positions;
+}
+
+struct MoveCounter {
+  std::size_t count = 0;
+
+  void operator()(hive::Move /*move*/) { ++count; }
+};
+
+/// Generators of the pieces looked up by kind through member pointers, the
+/// way piece moves used to be dispatched. The call through the pointer can't
+/// be inlined, unlike the switch of `for_each_piece_move`.
+using PieceGenerator = void (hive::Board::*)(hive::TilePointer, MoveCounter &);
+constexpr std::array<PieceGenerator, hive::NUMBER_OF_PIECES> PIECE_GENERATORS{
+    &hive::Board::generate<hive::PieceKind::Queen, MoveCounter &>,
+    &hive::Board::generate<hive::PieceKind::Spider, MoveCounter &>,
+    &hive::Board::generate<hive::PieceKind::Beetle, MoveCounter &>,
+    &hive::Board::generate<hive::PieceKind::Grasshopper, MoveCounter &>,
+    &hive::Board::generate<hive::PieceKind::Ant, MoveCounter &>,
+};
+
+template <typename Generate>
+void bench(
+    std::string_view name, std::vector<Position> &positions, Generate generate
+) {
+  const auto allocations_before = allocations.load();
+  const auto start = std::chrono::steady_clock::now();
+
+  std::size_t moves = 0;
+  for (std::size_t i = 0; i < REPETITIONS; ++i) {
+    for (auto &position : positions) {
+      moves += generate(position);
+    }
+  }
+
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  const auto allocated = allocations.load() - allocations_before;
+  const auto runs = static_cast<double>(REPETITIONS * positions.size());
+
+  std::println(
+      "{:<10} {:>10.0f} ns/position {:>10.2f} allocations/position "
+      "({} moves)",
+      name,
+      static_cast<double>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()
+      ) / runs,
+      static_cast<double>(allocated) / runs,
+      moves
+  );
+}
+
+/// Playouts per second and per thread of MCTS on the first few positions.
+void bench_mcts(const std::vector<Position> &positions, std::size_t threads) {
+  const hive::engine::HeuristicEvaluator evaluator;
+  hive::engine::Mcts mcts(
+      evaluator, {.playouts = MCTS_PLAYOUTS, .threads = threads, .seed = SEED}
+  );
+
+  std::size_t playouts = 0;
+  std::chrono::nanoseconds elapsed{0};
+
+  for (std::size_t i = 0; i < MCTS_POSITIONS && i < positions.size(); ++i) {
+    const auto result = mcts.run(positions[i].board, positions[i].player);
+    playouts += result.playouts;
+    elapsed += result.elapsed;
+  }
+
+  const auto seconds = std::chrono::duration<double>(elapsed).count();
+  const auto per_second = static_cast<double>(playouts) / seconds;
+
+  std::println(
+      "mcts {:>3} threads {:>10.0f} playouts/s {:>10.0f} playouts/s/thread",
+      threads,
+      per_second,
+      per_second / static_cast<double>(threads)
+  );
+}
+
+} // namespace
+
+int main() {
+  auto positions = random_positions(POSITION_COUNT);
+
+  std::println(
+      "Generating moves for {} positions, {} times",
+      positions.size(),
+      REPETITIONS
+  );
+
+  bench("generator", positions, [](Position &position) {
+    return static_cast<std::size_t>(std::ranges::distance(
+        position.board.moves_for_player(position.player)
+    ));
+  });
+
+  bench("move list", positions, [](Position &position) {
+    hive::MoveList moves;
+    position.board.moves_for_player(position.player, moves);
+    return moves.size();
+  });
+
+  // moves of the movable pieces only, to compare the two ways of dispatching
+  // on the kind of a piece
+  bench("pointers", positions, [](Position &position) {
+    MoveCounter counter;
+    for (const auto &[ptr, piece] : position.movable) {
+      const auto generator =
+          PIECE_GENERATORS[static_cast<std::size_t>(piece.kind)];
+      (position.board.*generator)(ptr, counter);
+    }
+    return counter.count;
+  });
+
+  bench("switch", positions, [](Position &position) {
+    MoveCounter counter;
+    for (const auto &[ptr, piece] : position.movable) {
+      position.board.for_each_piece_move(ptr, piece, counter);
+    }
+    return counter.count;
+  });
+
+  bench_mcts(positions, 1);
+  if (const auto threads = std::thread::hardware_concurrency(); threads > 1) {
+    bench_mcts(positions, threads);
+  }
+
+  return 0;
+}
@@ -12,6 +12,9 @@ public:
 
   hive::Player current_player() const { return _current_player; }
 
+  hive::GameResult result() const { return board.game_result(); }
+  bool is_over() const { return result() != hive::GameResult::InProgress; }
+
   void switch_player();
   bool can_place_piece(hive::PieceKind kind, hive::TilePointer ptr) const;
   void place_piece(hive::TilePointer ptr, hive::PieceKind kind);
@@ -16,8 +16,7 @@ std::generator<hive::TilePointer> clicable_tiles(const GameState &game) {
 }
 
 bool handle_kind_selection(GameState &game, HiveGuiState &gui_state) {
-  const auto &available =
-      game.board.get_player_pieces().at(game.current_player());
+  const auto available = game.board.get_player_pieces(game.current_player());
 
   // --- Build filtered list of available pieces for dropdown ---
   std::vector<hive::PieceKind> availableKinds;
@@ -82,6 +81,10 @@ bool tile_clicked(const HiveGuiState &gui_state, hive::TilePointer ptr) {
 } // namespace
 
 void handle_input(GameState &game, HiveGuiState &gui_state) {
+  if (game.is_over()) {
+    return;
+  }
+
   if (handle_kind_selection(game, gui_state)) {
     return;
   }
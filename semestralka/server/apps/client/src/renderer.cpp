@@ -57,10 +57,24 @@ const std::map<hive::PieceKind, raylib::Color> PIECE_COLORS = {
     {hive::PieceKind::Grasshopper, raylib::Color::DarkGreen()}
 };
 
+std::string turn_text(const GameState &game) {
+  switch (game.result()) {
+  case hive::GameResult::WhiteWon:
+    return "White won";
+  case hive::GameResult::BlackWon:
+    return "Black won";
+  case hive::GameResult::Draw:
+    return "Draw";
+  case hive::GameResult::InProgress:
+    break;
+  }
+
+  return game.current_player() == hive::Player::White ? "White's turn"
+                                                      : "Black's turn";
+}
+
 void draw_turn_label(const GameState &game, const HiveGuiState &gui) {
-  const std::string turnText = game.current_player() == hive::Player::White
-                                   ? "White's turn"
-                                   : "Black's turn";
+  const std::string turnText = turn_text(game);
   const auto label_width =
       static_cast<float>(raylib::MeasureText(turnText.data(), TEXT_FONT_SIZE));
 
@@ -121,8 +135,7 @@ void draw_tiles(const GameState &game, const HiveGuiState &gui_state) {
 }
 
 void draw_available(const GameState &game) {
-  const auto &available =
-      game.board.get_player_pieces().at(game.current_player());
+  const auto available = game.board.get_player_pieces(game.current_player());
 
   auto text = rayutils::empty_text(
       AVAILABLE_TEXT_FONT_SIZE, raylib::Color::DarkGray(), get_font()
@@ -0,0 +1,93 @@
+#include "corpus.h"
+#include <hive/types.h>
+
+namespace {
+
+using enum hive::PieceKind;
+using hive::make_move;
+using hive::make_placement;
+
+// The node counts were produced by this generator and cross-checked against
+// a straightforward copy-make generator built on the original per-piece
+// move functions. They follow the rules as implemented by `hive::Board`,
+// which doesn't stop the game when a queen is surrounded.
+const std::vector<ReferencePosition> POSITIONS{
+    {
+        .name = "start",
+        .moves = {},
+        .nodes = {5, 150, 2160, 31968, 750144, 17148030},
+    },
+    {
+        .name = "queens",
+        .moves =
+            {
+                make_placement({.p = 0, .q = 0}, Queen),
+                make_placement({.p = 1, .q = 0}, Queen),
+            },
+        .nodes = {12, 168, 3998, 85421, 2570688},
+    },
+    {
+        .name = "opening",
+        .moves =
+            {
+                make_placement({.p = 0, .q = 0}, Queen),
+                make_placement({.p = -1, .q = 1}, Beetle),
+                make_placement({.p = 0, .q = -1}, Beetle),
+                make_placement({.p = -1, .q = 2}, Spider),
+                make_placement({.p = 0, .q = -2}, Beetle),
+                make_placement({.p = 0, .q = 2}, Queen),
+                make_move({.p = 0, .q = -2}, {.p = -1, .q = -1}, Beetle),
+                make_move({.p = 0, .q = 2}, {.p = 0, .q = 1}, Queen),
+                make_placement({.p = -2, .q = -1}, Grasshopper),
+                make_placement({.p = -2, .q = 1}, Grasshopper),
+                make_placement({.p = -3, .q = 0}, Ant),
+                make_move({.p = -2, .q = 1}, {.p = 1, .q = 1}, Grasshopper),
+            },
+        .nodes = {47, 1761, 83982, 3302816},
+    },
+    {
+        .name = "midgame",
+        .moves =
+            {
+                make_placement({.p = 0, .q = 0}, Spider),
+                make_placement({.p = 1, .q = -1}, Ant),
+                make_placement({.p = -1, .q = 0}, Queen),
+                make_placement({.p = 1, .q = -2}, Beetle),
+                make_placement({.p = -2, .q = 1}, Ant),
+                make_placement({.p = 0, .q = -2}, Queen),
+                make_placement({.p = -3, .q = 2}, Spider),
+                make_placement({.p = 1, .q = -3}, Grasshopper),
+                make_placement({.p = -4, .q = 2}, Grasshopper),
+                make_placement({.p = 2, .q = -3}, Grasshopper),
+                make_placement({.p = -5, .q = 3}, Ant),
+                make_move({.p = 1, .q = -3}, {.p = 3, .q = -3}, Grasshopper),
+                make_placement({.p = -3, .q = 1}, Grasshopper),
+                make_placement({.p = 2, .q = -1}, Beetle),
+                make_move({.p = -5, .q = 3}, {.p = 3, .q = -4}, Ant),
+                make_placement({.p = 3, .q = -2}, Spider),
+                make_placement({.p = -2, .q = 2}, Beetle),
+                make_placement({.p = 3, .q = -1}, Ant),
+                make_placement({.p = -5, .q = 3}, Beetle),
+                make_move({.p = 0, .q = -2}, {.p = -1, .q = -1}, Queen),
+                make_move({.p = 3, .q = -4}, {.p = 0, .q = -2}, Ant),
+                make_placement({.p = 2, .q = -2}, Spider),
+                make_move({.p = 0, .q = -2}, {.p = -1, .q = -2}, Ant),
+                // the beetle climbs on top of the ant
+                make_move({.p = 2, .q = -1}, {.p = 1, .q = -1}, Beetle),
+            },
+        .nodes = {38, 1643, 59302, 2567016},
+    },
+};
+
+} // namespace
+
+hive::Player ReferencePosition::setup(hive::Board &board) const {
+  auto player = hive::Player::White;
+  for (const auto move : moves) {
+    board.apply_move(move, player);
+    player = hive::opponent(player);
+  }
+  return player;
+}
+
+std::span<const ReferencePosition> reference_positions() { return POSITIONS; }
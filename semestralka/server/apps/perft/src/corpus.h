@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <hive/board.h>
+#include <span>
+#include <string_view>
+#include <vector>
+
+/// Position with known perft results, used to catch regressions of the move
+/// generator.
+struct ReferencePosition {
+  std::string_view name;
+  /// Moves leading to the position from the empty board, white moves first.
+  std::vector<hive::Move> moves;
+  /// Expected `perft` results for depth 1, 2, ...
+  std::vector<std::size_t> nodes;
+
+  /// Play `moves` on an empty board, returns the player to move.
+  hive::Player setup(hive::Board &board) const;
+};
+
+std::span<const ReferencePosition> reference_positions();
@@ -0,0 +1,240 @@
+#include "corpus.h"
+#include "perft.h"
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <hive/board.h>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <threadpool/threadpool.h>
+#include <utils/print.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds_since(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+double nodes_per_second(std::size_t nodes, double seconds) {
+  return seconds > 0 ? static_cast<double>(nodes) / seconds : 0;
+}
+
+std::optional<std::size_t> parse_number(std::string_view str) {
+  std::size_t number = 0;
+  const auto [end, error] =
+      std::from_chars(str.data(), str.data() + str.size(), number);
+
+  if (error != std::errc{} || end != str.data() + str.size()) {
+    return std::nullopt;
+  }
+  return number;
+}
+
+const ReferencePosition *find_position(std::string_view name) {
+  for (const auto &position : reference_positions()) {
+    if (position.name == name) {
+      return &position;
+    }
+  }
+  return nullptr;
+}
+
+struct Options {
+  std::size_t threads = 1;
+  std::size_t split_depth = 1;
+  const ReferencePosition *position = nullptr;
+  std::size_t depth = 0;
+};
+
+/// Counts the nodes either on the calling thread or on a pool of workers.
+class Counter {
+public:
+  explicit Counter(const Options &options) : split_depth(options.split_depth) {
+    if (options.threads != 1) {
+      pool = std::make_unique<threadpool::Threadpool>(options.threads);
+    }
+  }
+
+  std::size_t
+  perft(hive::Board &board, hive::Player player, std::size_t depth) {
+    if (pool) {
+      return parallel_perft(board, player, depth, split_depth, *pool);
+    }
+    return ::perft(board, player, depth);
+  }
+
+  std::vector<DivideEntry>
+  divide(hive::Board &board, hive::Player player, std::size_t depth) {
+    if (pool) {
+      return parallel_divide(board, player, depth, split_depth, *pool);
+    }
+    return ::divide(board, player, depth);
+  }
+
+private:
+  std::size_t split_depth;
+  std::unique_ptr<threadpool::Threadpool> pool;
+};
+
+/// Run every reference position to its known depths, returns whether all
+/// counts matched.
+bool verify(Counter &counter) {
+  bool all_ok = true;
+
+  for (const auto &position : reference_positions()) {
+    hive::Board board;
+    const auto player = position.setup(board);
+
+    for (std::size_t depth = 1; depth <= position.nodes.size(); ++depth) {
+      const auto expected = position.nodes[depth - 1];
+
+      const auto start = Clock::now();
+      const auto nodes = counter.perft(board, player, depth);
+      const auto elapsed = seconds_since(start);
+
+      const bool ok = nodes == expected;
+      all_ok = all_ok && ok;
+
+      std::println(
+          "{:<10} depth {} {:>12} nodes {:>8.3f} s {:>12.0f} nodes/s {}",
+          position.name,
+          depth,
+          nodes,
+          elapsed,
+          nodes_per_second(nodes, elapsed),
+          ok ? "ok" : std::format("FAILED, expected {}", expected)
+      );
+    }
+  }
+
+  return all_ok;
+}
+
+void run_divide(
+    Counter &counter, const ReferencePosition &position, std::size_t depth
+) {
+  hive::Board board;
+  const auto player = position.setup(board);
+
+  const auto start = Clock::now();
+  const auto entries = counter.divide(board, player, depth);
+  const auto elapsed = seconds_since(start);
+
+  std::size_t total = 0;
+  for (const auto &[move, nodes] : entries) {
+    std::println("{}: {}", move, nodes);
+    total += nodes;
+  }
+
+  std::println();
+  std::println("Moves: {}", entries.size());
+  std::println("Nodes: {}", total);
+  std::println(
+      "Time: {:.3f} s ({:.0f} nodes/s)",
+      elapsed,
+      nodes_per_second(total, elapsed)
+  );
+}
+
+std::optional<Options> parse_options(std::span<char *> args) {
+  Options options;
+  std::vector<std::string_view> positional;
+
+  for (std::size_t i = 0; i < args.size(); ++i) {
+    const std::string_view arg = args[i];
+
+    if (arg == "-j" || arg == "--threads" || arg == "--split") {
+      if (i + 1 == args.size()) {
+        return std::nullopt;
+      }
+
+      const auto value = parse_number(args[++i]);
+      if (!value) {
+        return std::nullopt;
+      }
+
+      if (arg == "--split") {
+        options.split_depth = *value;
+      } else {
+        // 0 lets the pool pick the number of hardware threads
+        options.threads = *value;
+      }
+    } else {
+      positional.push_back(arg);
+    }
+  }
+
+  if (positional.empty()) {
+    return options;
+  }
+
+  if (positional.size() != 2) {
+    return std::nullopt;
+  }
+
+  options.position = find_position(positional[0]);
+  const auto depth = parse_number(positional[1]);
+
+  if (options.position == nullptr || !depth || *depth == 0) {
+    return std::nullopt;
+  }
+  options.depth = *depth;
+
+  return options;
+}
+
+void print_usage() {
+  std::println(std::cerr, "Usage: hive_perft [options] [<position> <depth>]");
+  std::println(std::cerr);
+  std::println(
+      std::cerr,
+      "Without a position, checks the move counts of all reference positions."
+  );
+  std::println(
+      std::cerr, "Otherwise prints the counts for each move of the position."
+  );
+  std::println(std::cerr);
+  std::println(std::cerr, "Options:");
+  std::println(
+      std::cerr,
+      "  -j, --threads <n>  count on n threads, 0 for all hardware threads "
+      "(default 1)"
+  );
+  std::println(
+      std::cerr,
+      "  --split <depth>    depth of the nodes counted as separate tasks "
+      "(default 1)"
+  );
+  std::println(std::cerr);
+  std::println(std::cerr, "Positions:");
+  for (const auto &position : reference_positions()) {
+    std::println(std::cerr, "  {}", position.name);
+  }
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  const auto options =
+      parse_options(std::span(argv, static_cast<std::size_t>(argc)).subspan(1));
+
+  if (!options) {
+    print_usage();
+    return 2;
+  }
+
+  Counter counter(*options);
+
+  if (options->position == nullptr) {
+    return verify(counter) ? 0 : 1;
+  }
+
+  run_divide(counter, *options->position, options->depth);
+
+  return 0;
+}
@@ -0,0 +1,147 @@
+#include "perft.h"
+#include <future>
+#include <hive/move_list.h>
+#include <memory>
+#include <numeric>
+
+std::size_t perft(hive::Board &board, hive::Player player, std::size_t depth) {
+  if (depth == 0) {
+    return 1;
+  }
+
+  hive::MoveList moves;
+  board.moves_for_player(player, moves);
+
+  // the leaves don't have to be played to be counted
+  if (depth == 1) {
+    return moves.size();
+  }
+
+  std::size_t nodes = 0;
+  for (const auto move : moves) {
+    const auto undo = board.make_move(move, player);
+    nodes += perft(board, hive::opponent(player), depth - 1);
+    board.unmake_move(undo);
+  }
+
+  return nodes;
+}
+
+std::vector<DivideEntry>
+divide(hive::Board &board, hive::Player player, std::size_t depth) {
+  hive::MoveList moves;
+  board.moves_for_player(player, moves);
+
+  std::vector<DivideEntry> result;
+  result.reserve(moves.size());
+
+  for (const auto move : moves) {
+    const auto undo = board.make_move(move, player);
+    result.push_back(
+        {.move = move, .nodes = perft(board, hive::opponent(player), depth - 1)}
+    );
+    board.unmake_move(undo);
+  }
+
+  return result;
+}
+
+namespace {
+
+using Futures = std::vector<std::future<std::size_t>>;
+
+/// Walk the tree down `split_depth` plies and spawn a task counting the
+/// subtree of every node found there.
+void spawn_subtrees(
+    hive::Board &board,
+    hive::Player player,
+    std::size_t depth,
+    std::size_t split_depth,
+    threadpool::Threadpool &pool,
+    Futures &futures
+) {
+  if (split_depth == 0 || depth <= 1) {
+    // the task only gets const access to its captures, so the copy is kept
+    // behind a pointer
+    futures.push_back(pool.spawn_with_future(
+        [board = std::make_shared<hive::Board>(board), player, depth] {
+          return perft(*board, player, depth);
+        }
+    ));
+    return;
+  }
+
+  hive::MoveList moves;
+  board.moves_for_player(player, moves);
+
+  for (const auto move : moves) {
+    const auto undo = board.make_move(move, player);
+    spawn_subtrees(
+        board, hive::opponent(player), depth - 1, split_depth - 1, pool, futures
+    );
+    board.unmake_move(undo);
+  }
+}
+
+} // namespace
+
+std::vector<DivideEntry> parallel_divide(
+    hive::Board &board,
+    hive::Player player,
+    std::size_t depth,
+    std::size_t split_depth,
+    threadpool::Threadpool &pool
+) {
+  hive::MoveList moves;
+  board.moves_for_player(player, moves);
+
+  // spawn everything first, the results are collected once all work is queued
+  std::vector<Futures> futures(moves.size());
+  for (std::size_t i = 0; i < moves.size(); ++i) {
+    const auto undo = board.make_move(moves[i], player);
+    spawn_subtrees(
+        board,
+        hive::opponent(player),
+        depth - 1,
+        split_depth == 0 ? 0 : split_depth - 1,
+        pool,
+        futures[i]
+    );
+    board.unmake_move(undo);
+  }
+
+  std::vector<DivideEntry> result;
+  result.reserve(moves.size());
+
+  for (std::size_t i = 0; i < moves.size(); ++i) {
+    std::size_t nodes = 0;
+    for (auto &future : futures[i]) {
+      nodes += future.get();
+    }
+    result.push_back({.move = moves[i], .nodes = nodes});
+  }
+
+  return result;
+}
+
+std::size_t parallel_perft(
+    hive::Board &board,
+    hive::Player player,
+    std::size_t depth,
+    std::size_t split_depth,
+    threadpool::Threadpool &pool
+) {
+  if (depth == 0) {
+    return 1;
+  }
+
+  const auto entries = parallel_divide(board, player, depth, split_depth, pool);
+  return std::accumulate(
+      entries.begin(),
+      entries.end(),
+      std::size_t{0},
+      [](std::size_t sum, const DivideEntry &entry) {
+        return sum + entry.nodes;
+      }
+  );
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <hive/board.h>
+#include <threadpool/threadpool.h>
+#include <vector>
+
+/// Number of leaf nodes of the tree of moves of depth `depth`, starting with
+/// `player` to move. The board is left as it was.
+std::size_t perft(hive::Board &board, hive::Player player, std::size_t depth);
+
+struct DivideEntry {
+  hive::Move move;
+  std::size_t nodes;
+};
+
+/// `perft` split by the root moves, to find which subtree differs from the
+/// reference. `depth` must be at least 1.
+std::vector<DivideEntry>
+divide(hive::Board &board, hive::Player player, std::size_t depth);
+
+/// `divide` where the subtrees below the nodes at `split_depth` (1 for the
+/// root moves) are counted by separate tasks of `pool`. Every task works on
+/// its own copy of the board.
+std::vector<DivideEntry> parallel_divide(
+    hive::Board &board,
+    hive::Player player,
+    std::size_t depth,
+    std::size_t split_depth,
+    threadpool::Threadpool &pool
+);
+
+/// `perft` counted in parallel, see `parallel_divide`.
+std::size_t parallel_perft(
+    hive::Board &board,
+    hive::Player player,
+    std::size_t depth,
+    std::size_t split_depth,
+    threadpool::Threadpool &pool
+);
@@ -0,0 +1,67 @@
+#include "game.h"
+#include <chrono>
+#include <engine/search.h>
+#include <engine/transposition_table.h>
+#include <hive/board.h>
+#include <hive/move_list.h>
+#include <optional>
+#include <random>
+
+std::vector<Record> play_game(
+    const hive::engine::Evaluator &evaluator,
+    const GameConfig &config,
+    std::uint64_t seed
+) {
+  std::mt19937_64 rng(seed);
+  hive::engine::TranspositionTable table(config.table_megabytes);
+  hive::engine::Search search(evaluator, table);
+
+  // the depth alone limits the search, so that the games are repeatable
+  const hive::engine::SearchLimits limits{
+      .time_budget = std::chrono::hours(1), .max_depth = config.depth
+  };
+
+  std::vector<Record> records;
+  hive::Board board;
+  auto player = hive::Player::White;
+  // games cut off after the last ply are draws
+  auto result = hive::GameResult::Draw;
+
+  for (std::size_t ply = 0; ply < config.max_plies; ++ply) {
+    std::optional<hive::Move> move;
+
+    if (ply < config.random_plies) {
+      hive::MoveList moves;
+      board.moves_for_player(player, moves);
+      if (!moves.empty()) {
+        move = moves[rng() % moves.size()];
+      }
+    } else {
+      table.new_search();
+      move = search.run(board, player, limits).best_move;
+    }
+
+    // a player without a move passes
+    if (move) {
+      if (const auto record = make_record(
+              board, player, *move, static_cast<std::uint16_t>(ply)
+          )) {
+        records.push_back(*record);
+      }
+      board.apply_move(*move, player);
+    }
+    player = hive::opponent(player);
+
+    if (const auto finished = board.game_result();
+        finished != hive::GameResult::InProgress) {
+      result = finished;
+      break;
+    }
+  }
+
+  for (auto &record : records) {
+    record.result = result;
+  }
+
+  return records;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "record.h"
+#include <cstddef>
+#include <cstdint>
+#include <engine/evaluation.h>
+#include <vector>
+
+struct GameConfig {
+  /// Depth searched for every move.
+  std::size_t depth = 3;
+  /// Plies played at random first, so that the games differ.
+  std::size_t random_plies = 4;
+  /// Games still running after this many plies are draws.
+  std::size_t max_plies = 200;
+  std::size_t table_megabytes = 1;
+};
+
+/// Play one game of the engine against itself, returning a record for every
+/// position from which a move was played, with the result filled in.
+std::vector<Record> play_game(
+    const hive::engine::Evaluator &evaluator,
+    const GameConfig &config,
+    std::uint64_t seed
+);
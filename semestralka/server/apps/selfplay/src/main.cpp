@@ -0,0 +1,204 @@
+#include "game.h"
+#include "shard_writer.h"
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <engine/evaluation.h>
+#include <engine/nnue.h>
+#include <exception>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <threadpool/threadpool.h>
+#include <utils/print.h>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Progress is reported after every this many games.
+constexpr std::size_t REPORT_INTERVAL = 100;
+
+std::optional<std::size_t> parse_number(std::string_view str) {
+  std::size_t number = 0;
+  const auto [end, error] =
+      std::from_chars(str.data(), str.data() + str.size(), number);
+
+  if (error != std::errc{} || end != str.data() + str.size()) {
+    return std::nullopt;
+  }
+  return number;
+}
+
+struct Options {
+  std::size_t threads = 0;
+  std::size_t games = 1000;
+  std::size_t shard_records = std::size_t{1} << 20U;
+  std::uint64_t seed = 0;
+  GameConfig game;
+  std::filesystem::path network;
+  std::filesystem::path output;
+};
+
+std::optional<Options> parse_options(std::span<char *> args) {
+  Options options;
+  std::vector<std::string_view> positional;
+
+  for (std::size_t i = 0; i < args.size(); ++i) {
+    const std::string_view arg = args[i];
+
+    if (arg == "--network") {
+      if (i + 1 == args.size()) {
+        return std::nullopt;
+      }
+      options.network = args[++i];
+    } else if (arg == "-j" || arg == "--threads" || arg == "-n" ||
+               arg == "--games" || arg == "--depth" || arg == "--random" ||
+               arg == "--shard" || arg == "--seed") {
+      if (i + 1 == args.size()) {
+        return std::nullopt;
+      }
+
+      const auto value = parse_number(args[++i]);
+      if (!value) {
+        return std::nullopt;
+      }
+
+      if (arg == "-j" || arg == "--threads") {
+        // 0 lets the pool pick the number of hardware threads
+        options.threads = *value;
+      } else if (arg == "-n" || arg == "--games") {
+        options.games = *value;
+      } else if (arg == "--depth") {
+        options.game.depth = *value;
+      } else if (arg == "--random") {
+        options.game.random_plies = *value;
+      } else if (arg == "--shard") {
+        options.shard_records = *value;
+      } else {
+        options.seed = *value;
+      }
+    } else {
+      positional.push_back(arg);
+    }
+  }
+
+  if (positional.size() != 1 || options.game.depth == 0 ||
+      options.shard_records == 0) {
+    return std::nullopt;
+  }
+  options.output = positional[0];
+
+  return options;
+}
+
+void print_usage() {
+  std::println(std::cerr, "Usage: hive_selfplay [options] <output directory>");
+  std::println(std::cerr);
+  std::println(
+      std::cerr,
+      "Plays the engine against itself and writes every position to binary "
+      "shards."
+  );
+  std::println(std::cerr);
+  std::println(std::cerr, "Options:");
+  std::println(
+      std::cerr,
+      "  -j, --threads <n>  play on n threads, 0 for all hardware threads "
+      "(default 0)"
+  );
+  std::println(
+      std::cerr, "  -n, --games <n>    number of games (default 1000)"
+  );
+  std::println(
+      std::cerr, "  --depth <n>        search depth of every move (default 3)"
+  );
+  std::println(
+      std::cerr, "  --random <n>       plies played at random first (default 4)"
+  );
+  std::println(
+      std::cerr, "  --shard <n>        records per shard (default 1048576)"
+  );
+  std::println(
+      std::cerr, "  --seed <n>         seed of the random plies (default 0)"
+  );
+  std::println(
+      std::cerr,
+      "  --network <file>   evaluate with the network, not the heuristic"
+  );
+}
+
+std::unique_ptr<hive::engine::Evaluator>
+make_evaluator(const Options &options) {
+  if (options.network.empty()) {
+    return std::make_unique<hive::engine::HeuristicEvaluator>();
+  }
+  return std::make_unique<hive::engine::NnueEvaluator>(options.network);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  const auto options =
+      parse_options(std::span(argv, static_cast<std::size_t>(argc)).subspan(1));
+
+  if (!options) {
+    print_usage();
+    return 2;
+  }
+
+  try {
+    const auto evaluator = make_evaluator(*options);
+    ShardWriter writer(options->output, options->shard_records);
+    threadpool::Threadpool pool(options->threads);
+
+    const auto start = Clock::now();
+
+    std::vector<std::future<void>> games;
+    games.reserve(options->games);
+
+    for (std::size_t i = 0; i < options->games; ++i) {
+      games.push_back(pool.spawn_with_future([&, i] {
+        const auto records =
+            play_game(*evaluator, options->game, options->seed + i);
+        writer.write(records);
+      }));
+    }
+
+    for (std::size_t i = 0; i < games.size(); ++i) {
+      games[i].get();
+
+      if ((i + 1) % REPORT_INTERVAL == 0 || i + 1 == games.size()) {
+        const auto seconds =
+            std::chrono::duration<double>(Clock::now() - start).count();
+        const auto positions = writer.records_written();
+
+        std::println(
+            "{} games, {} positions, {:.0f} positions/s",
+            i + 1,
+            positions,
+            static_cast<double>(positions) / seconds
+        );
+      }
+    }
+
+    writer.flush();
+    std::println(
+        "Wrote {} positions to {} shards in {}",
+        writer.records_written(),
+        writer.shards(),
+        options->output.string()
+    );
+  } catch (const std::exception &e) {
+    std::println(std::cerr, "Self-play failed: {}", e.what());
+    return 1;
+  }
+
+  return 0;
+}
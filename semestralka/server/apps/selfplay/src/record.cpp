@@ -0,0 +1,70 @@
+#include "record.h"
+#include <limits>
+
+namespace {
+
+bool fits(hive::Coordinate coordinate) {
+  return coordinate >= std::numeric_limits<std::int8_t>::min() &&
+         coordinate <= std::numeric_limits<std::int8_t>::max();
+}
+
+bool fits(hive::TilePointer ptr) { return fits(ptr.p) && fits(ptr.q); }
+
+} // namespace
+
+std::optional<Record> make_record(
+    const hive::Board &board,
+    hive::Player to_move,
+    hive::Move move,
+    std::uint16_t ply
+) {
+  if (!fits(move.from) || !fits(move.to)) {
+    return std::nullopt;
+  }
+
+  Record record{
+      .hash = board.hash(to_move),
+      .pieces = {},
+      .move =
+          {.from_p = static_cast<std::int8_t>(move.from.p),
+           .from_q = static_cast<std::int8_t>(move.from.q),
+           .to_p = static_cast<std::int8_t>(move.to.p),
+           .to_q = static_cast<std::int8_t>(move.to.q),
+           .kind = static_cast<std::uint8_t>(move.piece_kind)},
+      .to_move = to_move,
+      .result = hive::GameResult::InProgress,
+      .piece_count = 0,
+      .ply = ply,
+      .reserved = {}
+  };
+
+  for (auto &piece : record.pieces) {
+    piece.piece = PackedPiece::EMPTY;
+  }
+
+  for (const auto &[ptr, top] : board.pieces()) {
+    if (!fits(ptr)) {
+      return std::nullopt;
+    }
+
+    const auto &tile = board.get(ptr);
+    for (std::size_t height = 0; height < tile.size(); ++height) {
+      if (record.piece_count == Record::MAX_PIECES) {
+        return std::nullopt;
+      }
+
+      const auto piece = tile[height];
+      record.pieces[record.piece_count++] = {
+          .p = static_cast<std::int8_t>(ptr.p),
+          .q = static_cast<std::int8_t>(ptr.q),
+          .height = static_cast<std::uint8_t>(height),
+          .piece = static_cast<std::uint8_t>(
+              (static_cast<unsigned>(piece.kind) << 1U) |
+              static_cast<unsigned>(piece.owner)
+          )
+      };
+    }
+  }
+
+  return record;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <hive/board.h>
+#include <hive/types.h>
+#include <optional>
+
+/// Piece of a record, `EMPTY` in the `piece` byte marks unused slots.
+struct PackedPiece {
+  static constexpr std::uint8_t EMPTY = 0xFF;
+
+  std::int8_t p;
+  std::int8_t q;
+  /// 0 for the bottom of the stack.
+  std::uint8_t height;
+  /// Piece kind shifted left by one, or-ed with the owner.
+  std::uint8_t piece;
+};
+
+struct PackedMove {
+  std::int8_t from_p;
+  std::int8_t from_q;
+  std::int8_t to_p;
+  std::int8_t to_q;
+  std::uint8_t kind;
+};
+
+/// One position of a self-play game with the move played from it, written
+/// to the shards as is. The layout is fixed and little endian, so a shard is
+/// an array of records that can be mapped straight into memory.
+struct Record {
+  /// Nine pieces per player.
+  static constexpr std::size_t MAX_PIECES = 18;
+
+  /// Zobrist hash of the position including the player to move.
+  std::uint64_t hash;
+  /// Every piece on the board including the covered ones, bottom first.
+  std::array<PackedPiece, MAX_PIECES> pieces;
+  PackedMove move;
+  hive::Player to_move;
+  /// How the game ended, games cut off by the ply limit are draws.
+  hive::GameResult result;
+  std::uint8_t piece_count;
+  std::uint16_t ply;
+  std::array<std::uint8_t, 6> reserved;
+};
+
+static_assert(sizeof(Record) == 96);
+
+/// Record of `move` played by `to_move` at `board`, empty when a coordinate
+/// doesn't fit in a byte. The result is filled in once the game ends.
+std::optional<Record> make_record(
+    const hive::Board &board,
+    hive::Player to_move,
+    hive::Move move,
+    std::uint16_t ply
+);
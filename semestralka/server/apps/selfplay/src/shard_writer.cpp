@@ -0,0 +1,88 @@
+#include "shard_writer.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <utils/format.h>
+
+ShardWriter::ShardWriter(
+    std::filesystem::path directory, std::size_t records_per_shard
+)
+    : directory(std::move(directory)),
+      records_per_shard(std::max<std::size_t>(records_per_shard, 1)) {
+  std::filesystem::create_directories(this->directory);
+  buffer.reserve(BUFFER_RECORDS);
+}
+
+ShardWriter::~ShardWriter() {
+  try {
+    flush();
+  } catch (...) {
+    // nothing to report the error to this late
+  }
+}
+
+void ShardWriter::write(std::span<const Record> records) {
+  std::lock_guard lock(mutex);
+
+  for (const auto &record : records) {
+    buffer.push_back(record);
+    if (buffer.size() == BUFFER_RECORDS) {
+      flush_locked();
+    }
+  }
+}
+
+void ShardWriter::flush() {
+  std::lock_guard lock(mutex);
+  flush_locked();
+  file.flush();
+}
+
+std::size_t ShardWriter::records_written() const {
+  std::lock_guard lock(mutex);
+  return written + buffer.size();
+}
+
+std::size_t ShardWriter::shards() const {
+  std::lock_guard lock(mutex);
+  return shard_count;
+}
+
+void ShardWriter::flush_locked() {
+  std::span<const Record> pending = buffer;
+
+  while (!pending.empty()) {
+    if (!file.is_open() || in_shard == records_per_shard) {
+      open_next_shard();
+    }
+
+    const auto count = std::min(pending.size(), records_per_shard - in_shard);
+    file.write(
+        reinterpret_cast<const char *>(pending.data()),
+        static_cast<std::streamsize>(count * sizeof(Record))
+    );
+    if (!file) {
+      throw std::runtime_error("Failed to write shard");
+    }
+
+    in_shard += count;
+    written += count;
+    pending = pending.subspan(count);
+  }
+
+  buffer.clear();
+}
+
+void ShardWriter::open_next_shard() {
+  const auto path = directory / std::format("shard-{:05}.bin", shard_count);
+
+  file = std::ofstream(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    throw std::runtime_error(
+        std::format("Failed to create shard {}", path.string())
+    );
+  }
+
+  ++shard_count;
+  in_shard = 0;
+}
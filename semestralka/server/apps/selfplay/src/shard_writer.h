@@ -0,0 +1,50 @@
+#pragma once
+
+#include "record.h"
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <span>
+#include <vector>
+
+/// Appends records to numbered shard files in a directory, starting a new
+/// shard every `records_per_shard` records. Records are collected in a buffer
+/// and written in large blocks. Safe to use from many threads.
+class ShardWriter {
+public:
+  /// Records buffered before they are written out, 768 KiB.
+  static constexpr std::size_t BUFFER_RECORDS = 8192;
+
+  ShardWriter(std::filesystem::path directory, std::size_t records_per_shard);
+  ~ShardWriter();
+
+  ShardWriter(const ShardWriter &) = delete;
+  ShardWriter &operator=(const ShardWriter &) = delete;
+  ShardWriter(ShardWriter &&) = delete;
+  ShardWriter &operator=(ShardWriter &&) = delete;
+
+  /// Append `records` in order, the records of one call are not interleaved
+  /// with other threads.
+  void write(std::span<const Record> records);
+
+  /// Write the buffered records to the current shard.
+  void flush();
+
+  [[nodiscard]] std::size_t records_written() const;
+  [[nodiscard]] std::size_t shards() const;
+
+private:
+  std::filesystem::path directory;
+  std::size_t records_per_shard;
+
+  mutable std::mutex mutex;
+  std::vector<Record> buffer;
+  std::ofstream file;
+  std::size_t shard_count = 0;
+  std::size_t in_shard = 0;
+  std::size_t written = 0;
+
+  void flush_locked();
+  void open_next_shard();
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <engine/evaluation.h>
+#include <engine/opening_book.h>
+#include <engine/parallel_search.h>
+#include <engine/search.h>
+#include <engine/transposition_table.h>
+#include <hive/board.h>
+#include <hive/types.h>
+#include <memory>
+#include <optional>
+
+namespace hive::engine {
+
+struct BotConfig {
+  SearchLimits limits;
+  /// Search threads, 0 for one per hardware thread.
+  std::size_t threads = 1;
+  std::size_t table_megabytes = 16;
+  /// Consulted before searching, bots of a process can share one book.
+  std::shared_ptr<const OpeningBook> book;
+};
+
+/// Computer opponent playing with a fixed time budget per move, or instantly
+/// from its opening book.
+class Bot {
+public:
+  explicit Bot(
+      BotConfig config,
+      std::unique_ptr<Evaluator> evaluator =
+          std::make_unique<HeuristicEvaluator>()
+  );
+
+  /// Move to play for `player`, empty when `player` has to pass.
+  [[nodiscard]] std::optional<Move>
+  choose_move(const Board &board, Player player);
+
+  [[nodiscard]] const BotConfig &config() const { return _config; }
+
+private:
+  BotConfig _config;
+  std::unique_ptr<Evaluator> evaluator;
+  TranspositionTable table;
+  ParallelSearch search;
+};
+
+} // namespace hive::engine
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <hive/board.h>
+#include <hive/types.h>
+#include <memory>
+
+namespace hive::engine {
+
+using Score = std::int32_t;
+
+/// Score of a won position. Wins reached in fewer plies score higher.
+constexpr Score WIN = 30'000;
+/// Scores beyond this are forced wins or losses, not evaluations.
+constexpr Score WIN_THRESHOLD = WIN - 1'000;
+
+/// Static evaluation of positions used by the search.
+class Evaluator {
+public:
+  Evaluator() = default;
+  Evaluator(const Evaluator &) = default;
+  Evaluator(Evaluator &&) = default;
+  Evaluator &operator=(const Evaluator &) = default;
+  Evaluator &operator=(Evaluator &&) = default;
+
+  virtual ~Evaluator() = default;
+
+  /// Score of `board` from the point of view of `player`, positive when
+  /// `player` is better off. Must stay well within `WIN_THRESHOLD`.
+  [[nodiscard]] virtual Score
+  evaluate(const Board &board, Player player) const = 0;
+
+  /// Attach state that follows the changes of `board` and speeds up
+  /// evaluating it. The board must not change once the returned listener is
+  /// gone. Evaluators without such state detach the listener `board` may
+  /// have kept from the board it was copied from and return null.
+  [[nodiscard]] virtual std::unique_ptr<BoardListener>
+  attach(Board &board) const {
+    board.set_listener(nullptr);
+    return nullptr;
+  }
+};
+
+/// Hand-written evaluation based on how surrounded the queens are and how
+/// many pieces are free to move.
+class HeuristicEvaluator : public Evaluator {
+public:
+  [[nodiscard]] Score
+  evaluate(const Board &board, Player player) const override;
+
+private:
+  [[nodiscard]] static Score side_score(const Board &board, Player player);
+};
+
+} // namespace hive::engine
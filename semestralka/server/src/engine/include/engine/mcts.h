@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <engine/evaluation.h>
+#include <hive/board.h>
+#include <hive/types.h>
+#include <memory>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace hive::engine {
+
+struct MctsConfig {
+  /// Playouts per search, shared by all threads.
+  std::size_t playouts = 10'000;
+  /// Search threads, 0 for one per hardware thread.
+  std::size_t threads = 1;
+  /// Plies after which a playout stops and the evaluator picks the winner.
+  std::size_t playout_plies = 40;
+  /// Tree nodes allocated up front, the tree stops growing once they are
+  /// used up.
+  std::size_t node_capacity = std::size_t{1} << 18U;
+  /// Weight of the exploration term of UCT.
+  double exploration = 1.4;
+  std::uint64_t seed = 0;
+};
+
+struct MctsResult {
+  /// Empty when the player has no move and has to pass.
+  std::optional<Move> best_move;
+  std::size_t playouts = 0;
+  /// Share of the playouts through `best_move` won by the player, draws
+  /// count as half a win.
+  double win_rate = 0;
+  std::chrono::nanoseconds elapsed{0};
+};
+
+/// Monte Carlo tree search with UCT selection and random playouts.
+///
+/// Threads grow one shared tree. A thread descending through a node counts a
+/// visit right away and adds the reward only after its playout, which acts
+/// as a virtual loss and steers other threads to different branches. Nodes
+/// are expanded without locks: the thread that claims a node allocates its
+/// children from a preallocated arena and publishes them at once, the others
+/// run a playout from the node meanwhile.
+class Mcts {
+public:
+  Mcts(const Evaluator &evaluator, MctsConfig config);
+
+  /// Find the best move of `player`.
+  [[nodiscard]] MctsResult run(const Board &board, Player player);
+
+  [[nodiscard]] const MctsConfig &config() const { return _config; }
+
+private:
+  using NodeIndex = std::uint32_t;
+  using Rng = std::mt19937_64;
+
+  enum class NodeState : std::uint8_t { Leaf, Expanding, Expanded, Full };
+
+  struct Node {
+    Move move{};
+    /// No legal move was available, the player passed.
+    bool pass = false;
+    std::atomic<std::uint32_t> visits{0};
+    /// Twice the number of playouts through the node won by the player who
+    /// moved into it, draws count one.
+    std::atomic<std::uint32_t> reward{0};
+    std::atomic<NodeIndex> first_child{0};
+    std::atomic<std::uint16_t> child_count{0};
+    std::atomic<NodeState> state{NodeState::Leaf};
+  };
+
+  const Evaluator *evaluator;
+  MctsConfig _config;
+
+  std::unique_ptr<Node[]> nodes;
+  std::atomic<std::size_t> node_count{0};
+  std::atomic<std::size_t> playouts_started{0};
+
+  /// Run playouts on `board` until the budget is spent.
+  void work(Board board, Player player, Rng rng);
+
+  /// Try to add the children of `node`, returns whether it is expanded.
+  bool expand(Node &node, Board &board, Player player);
+
+  [[nodiscard]] NodeIndex select_child(const Node &node) const;
+
+  /// Twice the white wins of a random game from the position, draws count
+  /// one. The moves are left on the board and their undo info on `undo`.
+  [[nodiscard]] std::uint32_t playout(
+      Board &board,
+      Player player,
+      Rng &rng,
+      std::vector<Board::UndoInfo> &undo
+  ) const;
+
+  void init_node(NodeIndex idx, Move move, bool pass);
+};
+
+} // namespace hive::engine
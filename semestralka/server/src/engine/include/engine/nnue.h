@@ -0,0 +1,160 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <engine/evaluation.h>
+#include <filesystem>
+#include <hive/board.h>
+#include <hive/types.h>
+#include <memory>
+#include <optional>
+
+namespace hive::engine {
+
+/// Small quantized network read from a memory-mapped weights file.
+///
+/// Every piece on the board activates one input feature per perspective: its
+/// kind, whether it belongs to the perspective's player and where it lies
+/// relative to that player's queen. The first layer sums the weights of the
+/// active features into an accumulator of `HIDDEN` 16-bit values, which is
+/// updated incrementally as pieces come and go. Both accumulators, the
+/// player's one first, are clipped to 0..127 and fed to a single 8-bit output
+/// neuron.
+///
+/// The file holds a `FileHeader` followed by the feature weights
+/// (`FEATURES × HIDDEN` int16), the accumulator bias (`HIDDEN` int16), the
+/// output weights (`2 × HIDDEN` int8) and the output bias (int32), all little
+/// endian and without padding.
+class NnueNetwork {
+public:
+  static constexpr std::size_t HIDDEN = 32;
+  /// Pieces at most this many steps from the queen have a feature per cell.
+  static constexpr int RADIUS = 3;
+  /// 37 cells within the radius, and one for every cell beyond it or for
+  /// all pieces while the queen is not placed.
+  static constexpr std::size_t CELLS = 38;
+  static constexpr std::size_t FEATURES = 2 * NUMBER_OF_PIECES * CELLS;
+  /// The output neuron is divided by this to get a `Score`.
+  static constexpr Score OUTPUT_DIVISOR = 16;
+
+  static constexpr std::array<char, 8> MAGIC{
+      'H', 'I', 'V', 'E', 'N', 'N', 'U', 'E'
+  };
+  static constexpr std::uint32_t VERSION = 1;
+
+  struct FileHeader {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t features;
+    std::uint32_t hidden;
+    /// Keeps the weights 32-byte aligned for vector loads.
+    std::array<std::uint8_t, 44> reserved;
+  };
+  static_assert(sizeof(FileHeader) == 64);
+
+  /// Size of a valid weights file.
+  static constexpr std::size_t FILE_SIZE =
+      sizeof(FileHeader) + (FEATURES * HIDDEN * sizeof(std::int16_t)) +
+      (HIDDEN * sizeof(std::int16_t)) + (2 * HIDDEN * sizeof(std::int8_t)) +
+      sizeof(std::int32_t);
+
+  /// Map the weights file at `path`, throws `std::runtime_error` when it
+  /// can't be read or doesn't match the layout of the network.
+  explicit NnueNetwork(const std::filesystem::path &path);
+  ~NnueNetwork();
+
+  NnueNetwork(const NnueNetwork &) = delete;
+  NnueNetwork &operator=(const NnueNetwork &) = delete;
+  NnueNetwork(NnueNetwork &&) = delete;
+  NnueNetwork &operator=(NnueNetwork &&) = delete;
+
+  /// Feature of `piece` at `ptr` seen by `perspective`, whose queen stands at
+  /// `queen`.
+  [[nodiscard]] static std::size_t feature(
+      Player perspective,
+      std::optional<TilePointer> queen,
+      TilePointer ptr,
+      Piece piece
+  );
+
+  [[nodiscard]] const std::int16_t *weights(std::size_t feature) const {
+    return feature_weights + (feature * HIDDEN);
+  }
+
+  [[nodiscard]] const std::int16_t *bias() const { return feature_bias; }
+
+  /// Score for the player owning the accumulator `own`.
+  [[nodiscard]] Score forward(
+      const std::array<std::int16_t, HIDDEN> &own,
+      const std::array<std::int16_t, HIDDEN> &other
+  ) const;
+
+private:
+  void *mapping = nullptr;
+
+  const std::int16_t *feature_weights = nullptr;
+  const std::int16_t *feature_bias = nullptr;
+  const std::int8_t *output_weights = nullptr;
+  std::int32_t output_bias = 0;
+};
+
+/// First layer of an `NnueNetwork` for both perspectives, kept in sync with a
+/// board by listening to its changes.
+///
+/// Moving a queen moves the origin of every feature of its perspective, so
+/// that perspective is recomputed from the board on the next evaluation
+/// instead. A queen lifted and put back by the move generator doesn't count
+/// as a move.
+class NnueAccumulator : public BoardListener {
+public:
+  NnueAccumulator(const NnueNetwork &network, const Board &board);
+
+  void piece_added(TilePointer ptr, Piece piece) override;
+  void piece_removed(TilePointer ptr, Piece piece) override;
+
+  /// Score of the board for `player`.
+  [[nodiscard]] Score evaluate(Player player);
+
+  /// Whether the accumulator belongs to `network` and tracks `board`.
+  [[nodiscard]] bool
+  follows(const Board &board, const NnueNetwork &network) const {
+    return this->board == &board && this->network == &network;
+  }
+
+private:
+  struct Perspective {
+    alignas(32) std::array<std::int16_t, NnueNetwork::HIDDEN> values{};
+    std::optional<TilePointer> queen;
+    /// `values` match the pieces on the board.
+    bool valid = false;
+    /// The queen is off the board for a moment and no other piece has
+    /// changed since.
+    bool queen_lifted = false;
+  };
+
+  const NnueNetwork *network;
+  const Board *board;
+  std::array<Perspective, 2> perspectives;
+
+  void update(Player perspective, TilePointer ptr, Piece piece, bool added);
+  void refresh(Player perspective);
+};
+
+/// Evaluation by an `NnueNetwork`. Boards attached to the evaluator are
+/// evaluated incrementally, others from scratch.
+class NnueEvaluator : public Evaluator {
+public:
+  explicit NnueEvaluator(const std::filesystem::path &weights);
+
+  [[nodiscard]] Score
+  evaluate(const Board &board, Player player) const override;
+
+  [[nodiscard]] std::unique_ptr<BoardListener>
+  attach(Board &board) const override;
+
+private:
+  std::shared_ptr<const NnueNetwork> network;
+};
+
+} // namespace hive::engine
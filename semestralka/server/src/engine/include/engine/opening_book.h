@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <hive/board.h>
+#include <hive/types.h>
+#include <hive/zobrist.h>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace hive::engine {
+
+/// Move recommended by the book in the position with the hash `key`.
+struct BookEntry {
+  /// `Board::hash(to_move)` of the position.
+  zobrist::Key key;
+  std::int8_t from_p;
+  std::int8_t from_q;
+  std::int8_t to_p;
+  std::int8_t to_q;
+  PieceKind kind;
+  std::uint8_t reserved;
+  /// Relative preference among the moves of the position.
+  std::uint16_t weight;
+
+  /// Entry for `move`, empty when a coordinate doesn't fit in a byte.
+  [[nodiscard]] static std::optional<BookEntry>
+  make(zobrist::Key key, Move move, std::uint16_t weight);
+
+  [[nodiscard]] Move move() const;
+};
+
+static_assert(sizeof(BookEntry) == 16);
+
+/// Read-only opening book mapped straight from a file.
+///
+/// The file is a `FileHeader` followed by the entries sorted by key, several
+/// entries may share a key. Nothing is parsed when the book is opened and
+/// the pages are shared with every other process mapping the same file.
+/// Positions are found by interpolation search, which takes a couple of
+/// steps because the keys are spread uniformly.
+class OpeningBook {
+public:
+  static constexpr std::array<char, 8> MAGIC{
+      'H', 'I', 'V', 'E', 'B', 'O', 'O', 'K'
+  };
+  static constexpr std::uint32_t VERSION = 1;
+
+  struct FileHeader {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t reserved;
+  };
+  static_assert(sizeof(FileHeader) == sizeof(BookEntry));
+
+  /// Map the book at `path`, throws `std::runtime_error` when it can't be
+  /// read or is not a book.
+  explicit OpeningBook(const std::filesystem::path &path);
+  ~OpeningBook();
+
+  OpeningBook(const OpeningBook &) = delete;
+  OpeningBook &operator=(const OpeningBook &) = delete;
+  OpeningBook(OpeningBook &&) = delete;
+  OpeningBook &operator=(OpeningBook &&) = delete;
+
+  /// Write `entries` as a book to `path`, sorted by key.
+  static void
+  write(const std::filesystem::path &path, std::vector<BookEntry> entries);
+
+  /// All entries of the position with the hash `key`.
+  [[nodiscard]] std::span<const BookEntry> probe(zobrist::Key key) const;
+
+  /// The move with the highest weight for `player` at `board`, the first one
+  /// on ties. Empty when the position is not in the book.
+  [[nodiscard]] std::optional<Move>
+  best_move(const Board &board, Player player) const;
+
+  [[nodiscard]] std::size_t size() const { return entries.size(); }
+
+private:
+  void *mapping = nullptr;
+  std::size_t mapping_size = 0;
+  std::span<const BookEntry> entries;
+};
+
+} // namespace hive::engine
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <engine/evaluation.h>
+#include <engine/search.h>
+#include <engine/transposition_table.h>
+#include <hive/board.h>
+#include <hive/types.h>
+#include <vector>
+
+namespace hive::engine {
+
+/// Lazy SMP: several threads run the same iterative deepening search on
+/// their own copies of the board and share only the transposition table.
+///
+/// Helper threads start at alternating depths, so they fill the table with
+/// results the main thread needs next. Once the main thread finishes, the
+/// helpers are stopped through their stop tokens.
+class ParallelSearch {
+public:
+  /// Search with `threads` threads, 0 for one per hardware thread.
+  ParallelSearch(
+      const Evaluator &evaluator, TranspositionTable &table, std::size_t threads
+  );
+
+  /// Find the best move of `player`, using all threads.
+  [[nodiscard]] SearchResult
+  run(const Board &board, Player player, const SearchLimits &limits);
+
+  [[nodiscard]] std::size_t threads() const { return searches.size(); }
+
+private:
+  TranspositionTable *table;
+  std::vector<Search> searches;
+};
+
+} // namespace hive::engine
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <hive/board.h>
+#include <hive/types.h>
+#include <hive/zobrist.h>
+#include <optional>
+#include <vector>
+
+namespace hive::engine {
+
+struct SolverLimits {
+  /// Plies the attacker has to surround the queen in, both sides counted.
+  std::size_t max_plies = 5;
+  /// Nodes visited before giving up.
+  std::size_t max_nodes = 1'000'000;
+};
+
+enum class Proof : std::uint8_t {
+  /// The attacker surrounds the queen within the plies whatever the
+  /// defender does.
+  Win,
+  /// The defender holds out for the plies.
+  NoWin,
+  /// Ran out of nodes first.
+  Unknown,
+};
+
+struct SolverResult {
+  Proof proof = Proof::Unknown;
+  /// First move of the win, empty unless `proof` is `Proof::Win`.
+  std::optional<Move> move;
+  std::size_t nodes = 0;
+};
+
+/// Depth-first proof-number search (df-pn) of forced wins by surrounding the
+/// opponent's queen.
+///
+/// Every node keeps a proof and a disproof number, the number of leaves that
+/// still need to be solved to prove or disprove it. The search descends into
+/// the most proving child and stays there until the child's numbers exceed
+/// thresholds derived from its siblings. The numbers are kept in a hash
+/// table keyed by the position and the plies left, so transpositions are
+/// solved once. Nodes on the current path keep the numbers of their children
+/// themselves, so entries lost to collisions cost work but never stall the
+/// search.
+class ProofNumberSearch {
+public:
+  /// Allocate a table of at most `megabytes` MB.
+  explicit ProofNumberSearch(std::size_t table_megabytes = 16);
+
+  /// Solve whether `attacker`, who is to move, surrounds the queen of the
+  /// opponent within `limits.max_plies` plies. Positions where both queens
+  /// end up surrounded are draws, not wins.
+  [[nodiscard]] SolverResult
+  solve(Board board, Player attacker, const SolverLimits &limits);
+
+private:
+  struct Numbers {
+    std::uint32_t phi;
+    std::uint32_t delta;
+  };
+
+  struct Entry {
+    zobrist::Key key;
+    /// Proof number of the player to move reaching their goal, the attacker
+    /// wanting the win and the defender wanting to hold out.
+    std::uint32_t phi;
+    /// Disproof number of the same.
+    std::uint32_t delta;
+  };
+
+  std::vector<Entry> table;
+  Player attacker = Player::White;
+  std::size_t root_plies = 0;
+  std::optional<Move> root_move;
+  std::size_t nodes = 0;
+  std::size_t max_nodes = 0;
+  bool aborted = false;
+
+  /// Search the node until its numbers reach the thresholds and return
+  /// them.
+  Numbers mid(
+      Board &board,
+      Player player,
+      std::size_t plies,
+      std::uint32_t max_phi,
+      std::uint32_t max_delta
+  );
+
+  [[nodiscard]] const Entry *find(zobrist::Key key) const;
+  void store(const Entry &entry);
+};
+
+} // namespace hive::engine
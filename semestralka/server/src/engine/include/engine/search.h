@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <engine/evaluation.h>
+#include <engine/transposition_table.h>
+#include <hive/board.h>
+#include <hive/move_list.h>
+#include <hive/types.h>
+#include <optional>
+#include <stop_token>
+#include <vector>
+
+namespace hive::engine {
+
+struct SearchLimits {
+  /// Time after which the search stops and falls back to the result of the
+  /// last finished iteration.
+  std::chrono::milliseconds time_budget{1000};
+  /// Deepest iteration to run.
+  std::size_t max_depth = 64;
+};
+
+struct SearchResult {
+  /// Empty when the player has no move and has to pass.
+  std::optional<Move> best_move;
+  Score score = 0;
+  /// Depth of the last finished iteration.
+  std::size_t depth = 0;
+  std::size_t nodes = 0;
+};
+
+/// Negamax alpha-beta search with iterative deepening.
+///
+/// Results are cached in a transposition table, which may be shared with other
+/// searches. Moves are ordered by the best move stored in the table, two
+/// killer moves per ply and the history heuristic. One `Search` must not be
+/// used by several threads at once, the move ordering tables are reused
+/// between calls of `run`. Call `TranspositionTable::new_search` before
+/// searching a new position.
+class Search {
+public:
+  static constexpr std::size_t MAX_PLY = 64;
+
+  Search(const Evaluator &evaluator, TranspositionTable &table);
+
+  /// Find the best move of `player` within `limits`. The search also ends
+  /// soon after a stop is requested through `stop`. Iterative deepening
+  /// starts at `first_depth`, which lets parallel searches spread over
+  /// different depths.
+  [[nodiscard]] SearchResult run(
+      Board board,
+      Player player,
+      const SearchLimits &limits,
+      std::stop_token stop = {},
+      std::size_t first_depth = 1
+  );
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  const Evaluator *evaluator;
+  TranspositionTable *table;
+
+  std::array<std::array<std::optional<Move>, 2>, MAX_PLY> killers;
+  std::vector<Score> history;
+
+  Clock::time_point deadline;
+  std::stop_token stop_token;
+  bool stopped = false;
+  std::size_t nodes = 0;
+
+  Score negamax(
+      Board &board,
+      Player player,
+      std::size_t depth,
+      std::size_t ply,
+      Score alpha,
+      Score beta
+  );
+
+  /// Search all moves of the root, returns the best one and its score.
+  std::pair<std::optional<Move>, Score> search_root(
+      Board &board,
+      Player player,
+      std::size_t depth,
+      std::optional<Move> previous_best
+  );
+
+  /// Ordering keys of `moves`, higher keys are searched first.
+  void score_moves(
+      const MoveList &moves,
+      Player player,
+      std::size_t ply,
+      std::optional<Move> best,
+      std::array<Score, MoveList::CAPACITY> &scores
+  ) const;
+
+  /// Remember that `move` caused a beta cutoff.
+  void
+  store_cutoff(Move move, Player player, std::size_t depth, std::size_t ply);
+
+  /// Check the clock and the stop token every few thousand nodes, sets
+  /// `stopped` when the search has to end.
+  void check_stop();
+};
+
+} // namespace hive::engine
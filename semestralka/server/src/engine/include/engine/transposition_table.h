@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <engine/evaluation.h>
+#include <hive/types.h>
+#include <hive/zobrist.h>
+#include <optional>
+
+namespace hive::engine {
+
+/// How the stored score relates to the real score of the position.
+enum class Bound : std::uint8_t {
+  /// Marks empty slots.
+  None,
+  Exact,
+  /// The real score is at least the stored one (beta cutoff).
+  Lower,
+  /// The real score is at most the stored one (no move reached alpha).
+  Upper,
+};
+
+struct TableEntry {
+  /// Best move found, missing for fail-low nodes and for moves too far from
+  /// the center of the board to be packed.
+  std::optional<Move> move;
+  Score score = 0;
+  std::uint8_t depth = 0;
+  Bound bound = Bound::None;
+};
+
+/// Fixed-size hash table of search results shared by all search threads.
+///
+/// Buckets of four entries fill one cache line. Every entry is two 64-bit
+/// words, the packed data and the key XOR-ed with the data. Threads read and
+/// write the words without locks; an entry torn by a concurrent write no
+/// longer verifies against its key and is treated as a miss.
+class TranspositionTable {
+public:
+  static constexpr std::size_t BUCKET_ENTRIES = 4;
+
+  /// Allocate a table of at most `megabytes` MB, rounded down to a power of
+  /// two number of buckets. The memory is backed by huge pages when the
+  /// system provides them and is touched up front, so that the search doesn't
+  /// pay for page faults.
+  explicit TranspositionTable(std::size_t megabytes);
+  ~TranspositionTable();
+
+  TranspositionTable(const TranspositionTable &) = delete;
+  TranspositionTable &operator=(const TranspositionTable &) = delete;
+  TranspositionTable(TranspositionTable &&) = delete;
+  TranspositionTable &operator=(TranspositionTable &&) = delete;
+
+  [[nodiscard]] std::optional<TableEntry> probe(zobrist::Key key) const;
+
+  void store(zobrist::Key key, const TableEntry &entry);
+
+  /// Called at the start of every search, entries of older searches are
+  /// replaced first.
+  void new_search() { generation = (generation + 1) % GENERATIONS; }
+
+  /// Drop all entries.
+  void clear();
+
+  [[nodiscard]] std::size_t capacity() const {
+    return bucket_count * BUCKET_ENTRIES;
+  }
+
+  [[nodiscard]] bool uses_huge_pages() const { return huge_pages; }
+
+private:
+  static constexpr std::uint8_t GENERATIONS = 8;
+
+  struct alignas(64) Bucket {
+    struct Slot {
+      std::uint64_t check;
+      std::uint64_t data;
+    };
+
+    std::array<Slot, BUCKET_ENTRIES> slots;
+  };
+
+  Bucket *buckets = nullptr;
+  std::size_t bucket_count = 0;
+  std::size_t allocated_bytes = 0;
+  bool huge_pages = false;
+  std::uint8_t generation = 0;
+
+  [[nodiscard]] Bucket &bucket_for(zobrist::Key key) const {
+    return buckets[key & (bucket_count - 1)];
+  }
+};
+
+} // namespace hive::engine
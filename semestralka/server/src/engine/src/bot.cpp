@@ -0,0 +1,27 @@
+#include <engine/bot.h>
+#include <utility>
+
+namespace hive::engine {
+
+Bot::Bot(BotConfig config, std::unique_ptr<Evaluator> evaluator)
+    : _config(config), evaluator(std::move(evaluator)),
+      table(_config.table_megabytes),
+      search(*this->evaluator, table, _config.threads) {}
+
+std::optional<Move> Bot::choose_move(const Board &board, Player player) {
+  if (_config.book) {
+    if (const auto move = _config.book->best_move(board, player)) {
+      // guard against a hash collision with a position outside of the book,
+      // on a copy that doesn't report to the listener of the caller's board
+      Board copy = board;
+      copy.set_listener(nullptr);
+      if (copy.is_legal(*move, player)) {
+        return move;
+      }
+    }
+  }
+
+  return search.run(board, player, _config.limits).best_move;
+}
+
+} // namespace hive::engine
@@ -0,0 +1,35 @@
+#include <array>
+#include <engine/evaluation.h>
+
+namespace hive::engine {
+
+namespace {
+
+/// Penalty for the number of occupied neighbors of a queen. Grows faster than
+/// linearly, the last free cells around a queen are the valuable ones.
+constexpr std::array<Score, 7> QUEEN_NEIGHBOR_PENALTY{
+    0, 20, 50, 100, 200, 400, 0
+};
+
+constexpr Score FREE_PIECE = 15;
+constexpr Score QUEEN_IN_RESERVE = 60;
+
+} // namespace
+
+Score HeuristicEvaluator::evaluate(const Board &board, Player player) const {
+  return side_score(board, player) - side_score(board, opponent(player));
+}
+
+Score HeuristicEvaluator::side_score(const Board &board, Player player) {
+  if (!board.has_placed_queen(player)) {
+    return -QUEEN_IN_RESERVE;
+  }
+
+  const auto free_pieces =
+      (board.get_layers().of(player) & ~board.pinned_tiles()).count();
+
+  return (FREE_PIECE * static_cast<Score>(free_pieces)) -
+         QUEEN_NEIGHBOR_PENALTY[board.queen_neighbors(player)];
+}
+
+} // namespace hive::engine
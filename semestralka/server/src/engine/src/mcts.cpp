@@ -0,0 +1,285 @@
+#include <algorithm>
+#include <cmath>
+#include <engine/mcts.h>
+#include <hive/move_list.h>
+#include <limits>
+#include <thread>
+#include <utility>
+
+namespace hive::engine {
+
+namespace {
+
+constexpr std::uint32_t WIN_REWARD = 2;
+constexpr std::uint32_t DRAW_REWARD = 1;
+
+/// Nodes are expanded on their second visit, so that the playouts that only
+/// pass through once don't fill the arena with children nobody looks at.
+constexpr std::uint32_t EXPAND_VISITS = 2;
+
+/// Twice the white wins of a finished game, empty while the game goes on.
+std::optional<std::uint32_t> white_reward(const Board &board) {
+  switch (board.game_result()) {
+  case GameResult::InProgress:
+    return std::nullopt;
+  case GameResult::WhiteWon:
+    return WIN_REWARD;
+  case GameResult::BlackWon:
+    return 0;
+  case GameResult::Draw:
+    return DRAW_REWARD;
+  }
+  return std::nullopt;
+}
+
+/// Reward of `player` given the reward of white.
+std::uint32_t reward_for(Player player, std::uint32_t white) {
+  return player == Player::White ? white : WIN_REWARD - white;
+}
+
+} // namespace
+
+Mcts::Mcts(const Evaluator &evaluator, MctsConfig config)
+    : evaluator(&evaluator), _config(config) {
+  if (_config.threads == 0) {
+    _config.threads = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+  // the root is always there and the indices have to fit in a node
+  _config.node_capacity = std::clamp<std::size_t>(
+      _config.node_capacity, 1, std::numeric_limits<NodeIndex>::max()
+  );
+
+  nodes = std::make_unique<Node[]>(_config.node_capacity);
+}
+
+MctsResult Mcts::run(const Board &board, Player player) {
+  const auto start = std::chrono::steady_clock::now();
+
+  node_count.store(1);
+  playouts_started.store(0);
+  init_node(0, Move{}, false);
+
+  {
+    std::vector<std::jthread> helpers;
+    helpers.reserve(_config.threads - 1);
+
+    for (std::size_t i = 1; i < _config.threads; ++i) {
+      helpers.emplace_back([this, &board, player, i] {
+        work(board, player, Rng(_config.seed + i));
+      });
+    }
+
+    work(board, player, Rng(_config.seed));
+  } // the helpers are joined here
+
+  MctsResult result;
+  result.playouts = std::min(playouts_started.load(), _config.playouts);
+  result.elapsed = std::chrono::steady_clock::now() - start;
+
+  const auto &root = nodes[0];
+  if (root.state.load() != NodeState::Expanded) {
+    return result;
+  }
+
+  // the most visited move is the most reliable one
+  const auto first = root.first_child.load();
+  const auto count = root.child_count.load();
+  const Node *best = nullptr;
+
+  for (NodeIndex idx = first; idx < first + count; ++idx) {
+    const auto &child = nodes[idx];
+    if (best == nullptr || child.visits.load() > best->visits.load()) {
+      best = &child;
+    }
+  }
+
+  if (best != nullptr && !best->pass) {
+    result.best_move = best->move;
+    const auto visits = best->visits.load();
+    if (visits > 0) {
+      result.win_rate = static_cast<double>(best->reward.load()) /
+                        static_cast<double>(WIN_REWARD * visits);
+    }
+  }
+
+  return result;
+}
+
+void Mcts::work(Board board, Player player, Rng rng) {
+  const auto listener = evaluator->attach(board);
+  std::vector<NodeIndex> path;
+  std::vector<Board::UndoInfo> undo;
+
+  while (playouts_started.fetch_add(1, std::memory_order_relaxed) <
+         _config.playouts) {
+    path.clear();
+    undo.clear();
+
+    auto to_move = player;
+    NodeIndex idx = 0;
+    path.push_back(idx);
+    nodes[idx].visits.fetch_add(1, std::memory_order_relaxed);
+
+    std::optional<std::uint32_t> white;
+
+    // selection, every visit is counted on the way down and acts as a
+    // virtual loss until the reward arrives
+    while (true) {
+      white = white_reward(board);
+      if (white) {
+        break;
+      }
+
+      auto &node = nodes[idx];
+      if (node.state.load(std::memory_order_acquire) != NodeState::Expanded) {
+        const bool ready =
+            (idx == 0 ||
+             node.visits.load(std::memory_order_relaxed) >= EXPAND_VISITS) &&
+            expand(node, board, to_move);
+        if (!ready) {
+          break;
+        }
+      }
+
+      idx = select_child(node);
+      auto &child = nodes[idx];
+      child.visits.fetch_add(1, std::memory_order_relaxed);
+      path.push_back(idx);
+
+      if (!child.pass) {
+        undo.push_back(board.make_move(child.move, to_move));
+      }
+      to_move = opponent(to_move);
+    }
+
+    if (!white) {
+      white = playout(board, to_move, rng, undo);
+    }
+
+    // each node is rewarded for the player who moved into it, the parent's
+    // player to move, which is what UCT of the parent maximizes
+    auto mover = opponent(player);
+    for (const auto node : path) {
+      nodes[node].reward.fetch_add(
+          reward_for(mover, *white), std::memory_order_relaxed
+      );
+      mover = opponent(mover);
+    }
+
+    for (auto it = undo.rbegin(); it != undo.rend(); ++it) {
+      board.unmake_move(*it);
+    }
+  }
+}
+
+bool Mcts::expand(Node &node, Board &board, Player player) {
+  auto expected = NodeState::Leaf;
+  if (!node.state.compare_exchange_strong(
+          expected, NodeState::Expanding, std::memory_order_acquire
+      )) {
+    // someone else is expanding the node or the arena is full
+    return expected == NodeState::Expanded;
+  }
+
+  MoveList moves;
+  board.moves_for_player(player, moves);
+  const auto count = std::max<std::size_t>(moves.size(), 1);
+
+  const auto first = node_count.fetch_add(count, std::memory_order_relaxed);
+  if (first + count > _config.node_capacity) {
+    node.state.store(NodeState::Full, std::memory_order_release);
+    return false;
+  }
+
+  const auto first_idx = static_cast<NodeIndex>(first);
+  if (moves.empty()) {
+    init_node(first_idx, Move{}, true);
+  }
+  for (std::size_t i = 0; i < moves.size(); ++i) {
+    init_node(static_cast<NodeIndex>(first + i), moves[i], false);
+  }
+
+  node.first_child.store(first_idx, std::memory_order_relaxed);
+  node.child_count.store(
+      static_cast<std::uint16_t>(count), std::memory_order_relaxed
+  );
+  node.state.store(NodeState::Expanded, std::memory_order_release);
+  return true;
+}
+
+Mcts::NodeIndex Mcts::select_child(const Node &node) const {
+  const auto first = node.first_child.load(std::memory_order_relaxed);
+  const auto count = node.child_count.load(std::memory_order_relaxed);
+
+  const auto parent_visits = node.visits.load(std::memory_order_relaxed);
+  const auto log_visits = std::log(static_cast<double>(parent_visits) + 1);
+
+  auto best = first;
+  auto best_score = -std::numeric_limits<double>::infinity();
+
+  for (NodeIndex idx = first; idx < first + count; ++idx) {
+    const auto &child = nodes[idx];
+    const auto visits = child.visits.load(std::memory_order_relaxed);
+    if (visits == 0) {
+      return idx;
+    }
+
+    const auto n = static_cast<double>(visits);
+    const auto reward =
+        static_cast<double>(child.reward.load(std::memory_order_relaxed));
+    const auto value = reward / (WIN_REWARD * n);
+    const auto score =
+        value + (_config.exploration * std::sqrt(log_visits / n));
+
+    if (score > best_score) {
+      best = idx;
+      best_score = score;
+    }
+  }
+
+  return best;
+}
+
+std::uint32_t Mcts::playout(
+    Board &board,
+    Player player,
+    Rng &rng,
+    std::vector<Board::UndoInfo> &undo
+) const {
+  std::optional<std::uint32_t> white;
+  MoveList moves;
+
+  for (std::size_t ply = 0; ply < _config.playout_plies; ++ply) {
+    moves.clear();
+    board.moves_for_player(player, moves);
+
+    if (!moves.empty()) {
+      undo.push_back(board.make_move(moves[rng() % moves.size()], player));
+      white = white_reward(board);
+      if (white) {
+        break;
+      }
+    }
+    player = opponent(player);
+  }
+
+  if (!white) {
+    const auto score = evaluator->evaluate(board, Player::White);
+    white = score > 0 ? WIN_REWARD : score < 0 ? 0 : DRAW_REWARD;
+  }
+
+  return *white;
+}
+
+void Mcts::init_node(NodeIndex idx, Move move, bool pass) {
+  auto &node = nodes[idx];
+  node.move = move;
+  node.pass = pass;
+  node.visits.store(0, std::memory_order_relaxed);
+  node.reward.store(0, std::memory_order_relaxed);
+  node.first_child.store(0, std::memory_order_relaxed);
+  node.child_count.store(0, std::memory_order_relaxed);
+  node.state.store(NodeState::Leaf, std::memory_order_relaxed);
+}
+
+} // namespace hive::engine
@@ -0,0 +1,327 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <engine/nnue.h>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utils/format.h>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace hive::engine {
+
+namespace {
+
+constexpr int SIDE = (2 * NnueNetwork::RADIUS) + 1;
+constexpr auto FAR_CELL = static_cast<std::uint8_t>(NnueNetwork::CELLS - 1);
+constexpr std::int16_t CLIP = 127;
+
+/// Cell of every offset from the queen within the square of side `SIDE`
+/// around it, `FAR_CELL` for offsets beyond the radius.
+constexpr auto CELL_TABLE = [] {
+  std::array<std::uint8_t, SIDE * SIDE> table{};
+  std::uint8_t next = 0;
+
+  for (int dq = -NnueNetwork::RADIUS; dq <= NnueNetwork::RADIUS; ++dq) {
+    for (int dp = -NnueNetwork::RADIUS; dp <= NnueNetwork::RADIUS; ++dp) {
+      const auto distance = std::max({dp, -dp, dq, -dq, dp + dq, -dp - dq});
+      const auto slot = ((dq + NnueNetwork::RADIUS) * SIDE) + dp +
+                        NnueNetwork::RADIUS;
+      table[slot] = distance <= NnueNetwork::RADIUS ? next++ : FAR_CELL;
+    }
+  }
+
+  return table;
+}();
+
+static_assert(
+    std::ranges::count_if(
+        CELL_TABLE, [](std::uint8_t cell) { return cell != FAR_CELL; }
+    ) == NnueNetwork::CELLS - 1
+);
+
+std::uint8_t cell(TilePointer queen, TilePointer ptr) {
+  const auto dp = ptr.p - queen.p;
+  const auto dq = ptr.q - queen.q;
+  if (std::abs(dp) > NnueNetwork::RADIUS ||
+      std::abs(dq) > NnueNetwork::RADIUS) {
+    return FAR_CELL;
+  }
+  return CELL_TABLE
+      [((dq + NnueNetwork::RADIUS) * SIDE) + dp + NnueNetwork::RADIUS];
+}
+
+void add_weights(
+    std::array<std::int16_t, NnueNetwork::HIDDEN> &values,
+    const std::int16_t *weights
+) {
+  for (std::size_t i = 0; i < NnueNetwork::HIDDEN; ++i) {
+    values[i] = static_cast<std::int16_t>(values[i] + weights[i]);
+  }
+}
+
+void sub_weights(
+    std::array<std::int16_t, NnueNetwork::HIDDEN> &values,
+    const std::int16_t *weights
+) {
+  for (std::size_t i = 0; i < NnueNetwork::HIDDEN; ++i) {
+    values[i] = static_cast<std::int16_t>(values[i] - weights[i]);
+  }
+}
+
+#ifdef __AVX2__
+
+/// Clipped accumulator times the output weights, 32 values at a time.
+std::int32_t dot(
+    const std::array<std::int16_t, NnueNetwork::HIDDEN> &values,
+    const std::int8_t *weights
+) {
+  static_assert(NnueNetwork::HIDDEN % 32 == 0);
+
+  const auto clip = _mm256_set1_epi8(CLIP);
+  const auto ones = _mm256_set1_epi16(1);
+  auto sum = _mm256_setzero_si256();
+
+  for (std::size_t i = 0; i < NnueNetwork::HIDDEN; i += 32) {
+    const auto low = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(values.data() + i)
+    );
+    const auto high = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(values.data() + i + 16)
+    );
+
+    // packing saturates to 0..255 and interleaves the 128-bit lanes, the
+    // permutation puts them back in order
+    const auto packed = _mm256_permute4x64_epi64(
+        _mm256_packus_epi16(low, high), 0b11'01'10'00
+    );
+    const auto clipped = _mm256_min_epu8(packed, clip);
+
+    const auto products = _mm256_maddubs_epi16(
+        clipped,
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(weights + i))
+    );
+    sum = _mm256_add_epi32(sum, _mm256_madd_epi16(products, ones));
+  }
+
+  const auto half = _mm_add_epi32(
+      _mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1)
+  );
+  const auto quarter = _mm_add_epi32(half, _mm_unpackhi_epi64(half, half));
+  const auto eighth =
+      _mm_add_epi32(quarter, _mm_shuffle_epi32(quarter, 0b00'00'00'01));
+  return _mm_cvtsi128_si32(eighth);
+}
+
+#else
+
+std::int32_t dot(
+    const std::array<std::int16_t, NnueNetwork::HIDDEN> &values,
+    const std::int8_t *weights
+) {
+  std::int32_t sum = 0;
+  for (std::size_t i = 0; i < NnueNetwork::HIDDEN; ++i) {
+    const auto clipped = std::clamp<std::int16_t>(values[i], 0, CLIP);
+    sum += std::int32_t{clipped} * weights[i];
+  }
+  return sum;
+}
+
+#endif
+
+} // namespace
+
+NnueNetwork::NnueNetwork(const std::filesystem::path &path) {
+  const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::runtime_error(
+        std::format("Failed to open network {}", path.string())
+    );
+  }
+
+  struct stat info{};
+  if (::fstat(fd, &info) != 0 ||
+      static_cast<std::size_t>(info.st_size) != FILE_SIZE) {
+    ::close(fd);
+    throw std::runtime_error(
+        std::format("Network {} has the wrong size", path.string())
+    );
+  }
+
+  mapping = ::mmap(nullptr, FILE_SIZE, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    mapping = nullptr;
+    throw std::runtime_error(
+        std::format("Failed to map network {}", path.string())
+    );
+  }
+
+  const auto *bytes = static_cast<const std::uint8_t *>(mapping);
+
+  FileHeader header{};
+  std::memcpy(&header, bytes, sizeof(header));
+  if (header.magic != MAGIC || header.version != VERSION ||
+      header.features != FEATURES || header.hidden != HIDDEN) {
+    ::munmap(mapping, FILE_SIZE);
+    mapping = nullptr;
+    throw std::runtime_error(
+        std::format("Network {} has an unknown format", path.string())
+    );
+  }
+
+  // the mapping is page aligned and every section is a multiple of 32 bytes
+  // long, so the weights are properly aligned
+  bytes += sizeof(FileHeader);
+  feature_weights = reinterpret_cast<const std::int16_t *>(bytes);
+  bytes += FEATURES * HIDDEN * sizeof(std::int16_t);
+  feature_bias = reinterpret_cast<const std::int16_t *>(bytes);
+  bytes += HIDDEN * sizeof(std::int16_t);
+  output_weights = reinterpret_cast<const std::int8_t *>(bytes);
+  bytes += 2 * HIDDEN * sizeof(std::int8_t);
+  std::memcpy(&output_bias, bytes, sizeof(output_bias));
+}
+
+NnueNetwork::~NnueNetwork() {
+  if (mapping != nullptr) {
+    ::munmap(mapping, FILE_SIZE);
+  }
+}
+
+std::size_t NnueNetwork::feature(
+    Player perspective,
+    std::optional<TilePointer> queen,
+    TilePointer ptr,
+    Piece piece
+) {
+  const auto theirs = static_cast<std::size_t>(piece.owner != perspective);
+  const auto kind = static_cast<std::size_t>(piece.kind);
+  const auto where = queen ? cell(*queen, ptr) : FAR_CELL;
+
+  return (((theirs * NUMBER_OF_PIECES) + kind) * CELLS) + where;
+}
+
+Score NnueNetwork::forward(
+    const std::array<std::int16_t, HIDDEN> &own,
+    const std::array<std::int16_t, HIDDEN> &other
+) const {
+  const auto sum = dot(own, output_weights) +
+                   dot(other, output_weights + HIDDEN) + output_bias;
+
+  // keep clear of the scores of won games
+  return std::clamp<Score>(
+      sum / OUTPUT_DIVISOR, -WIN_THRESHOLD + 1, WIN_THRESHOLD - 1
+  );
+}
+
+NnueAccumulator::NnueAccumulator(
+    const NnueNetwork &network, const Board &board
+)
+    : network(&network), board(&board) {}
+
+void NnueAccumulator::piece_added(TilePointer ptr, Piece piece) {
+  for (const auto player : {Player::White, Player::Black}) {
+    update(player, ptr, piece, true);
+  }
+}
+
+void NnueAccumulator::piece_removed(TilePointer ptr, Piece piece) {
+  for (const auto player : {Player::White, Player::Black}) {
+    update(player, ptr, piece, false);
+  }
+}
+
+Score NnueAccumulator::evaluate(Player player) {
+  for (const auto perspective : {Player::White, Player::Black}) {
+    auto &side = perspectives[static_cast<std::uint8_t>(perspective)];
+    if (!side.valid || side.queen_lifted) {
+      refresh(perspective);
+    }
+  }
+
+  return network->forward(
+      perspectives[static_cast<std::uint8_t>(player)].values,
+      perspectives[static_cast<std::uint8_t>(opponent(player))].values
+  );
+}
+
+void NnueAccumulator::update(
+    Player perspective, TilePointer ptr, Piece piece, bool added
+) {
+  auto &side = perspectives[static_cast<std::uint8_t>(perspective)];
+  if (!side.valid) {
+    return;
+  }
+
+  if (piece.kind == PieceKind::Queen && piece.owner == perspective) {
+    if (!added) {
+      side.queen_lifted = true;
+    } else if (side.queen_lifted && side.queen == ptr) {
+      side.queen_lifted = false;
+    } else {
+      side.valid = false;
+    }
+    return;
+  }
+
+  if (side.queen_lifted) {
+    // the queen is not coming back to a board that's still the same
+    side.valid = false;
+    return;
+  }
+
+  const auto feature =
+      NnueNetwork::feature(perspective, side.queen, ptr, piece);
+  const auto *weights = network->weights(feature);
+  if (added) {
+    add_weights(side.values, weights);
+  } else {
+    sub_weights(side.values, weights);
+  }
+}
+
+void NnueAccumulator::refresh(Player perspective) {
+  auto &side = perspectives[static_cast<std::uint8_t>(perspective)];
+  std::copy_n(network->bias(), NnueNetwork::HIDDEN, side.values.begin());
+  side.queen = board->queen_position(perspective);
+
+  for (const auto &[ptr, top] : board->pieces()) {
+    for (const auto piece : board->get(ptr)) {
+      add_weights(
+          side.values,
+          network->weights(
+              NnueNetwork::feature(perspective, side.queen, ptr, piece)
+          )
+      );
+    }
+  }
+
+  side.valid = true;
+  side.queen_lifted = false;
+}
+
+NnueEvaluator::NnueEvaluator(const std::filesystem::path &weights)
+    : network(std::make_shared<const NnueNetwork>(weights)) {}
+
+Score NnueEvaluator::evaluate(const Board &board, Player player) const {
+  auto *accumulator = dynamic_cast<NnueAccumulator *>(board.get_listener());
+  if (accumulator != nullptr && accumulator->follows(board, *network)) {
+    return accumulator->evaluate(player);
+  }
+
+  NnueAccumulator scratch(*network, board);
+  return scratch.evaluate(player);
+}
+
+std::unique_ptr<BoardListener> NnueEvaluator::attach(Board &board) const {
+  auto accumulator = std::make_unique<NnueAccumulator>(*network, board);
+  board.set_listener(accumulator.get());
+  return accumulator;
+}
+
+} // namespace hive::engine
@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <cstring>
+#include <engine/opening_book.h>
+#include <fcntl.h>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utils/format.h>
+
+namespace hive::engine {
+
+namespace {
+
+/// Ranges this short are finished by binary search.
+constexpr std::size_t INTERPOLATION_LIMIT = 16;
+
+bool fits(Coordinate coordinate) {
+  return coordinate >= std::numeric_limits<std::int8_t>::min() &&
+         coordinate <= std::numeric_limits<std::int8_t>::max();
+}
+
+} // namespace
+
+std::optional<BookEntry>
+BookEntry::make(zobrist::Key key, Move move, std::uint16_t weight) {
+  if (!fits(move.from.p) || !fits(move.from.q) || !fits(move.to.p) ||
+      !fits(move.to.q)) {
+    return std::nullopt;
+  }
+
+  return BookEntry{
+      .key = key,
+      .from_p = static_cast<std::int8_t>(move.from.p),
+      .from_q = static_cast<std::int8_t>(move.from.q),
+      .to_p = static_cast<std::int8_t>(move.to.p),
+      .to_q = static_cast<std::int8_t>(move.to.q),
+      .kind = move.piece_kind,
+      .reserved = 0,
+      .weight = weight
+  };
+}
+
+Move BookEntry::move() const {
+  return {
+      .from = {.p = from_p, .q = from_q},
+      .to = {.p = to_p, .q = to_q},
+      .piece_kind = kind
+  };
+}
+
+OpeningBook::OpeningBook(const std::filesystem::path &path) {
+  const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::runtime_error(
+        std::format("Failed to open book {}", path.string())
+    );
+  }
+
+  struct stat info{};
+  if (::fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw std::runtime_error(
+        std::format("Failed to read book {}", path.string())
+    );
+  }
+
+  const auto size = static_cast<std::size_t>(info.st_size);
+  if (size < sizeof(FileHeader) ||
+      (size - sizeof(FileHeader)) % sizeof(BookEntry) != 0) {
+    ::close(fd);
+    throw std::runtime_error(
+        std::format("Book {} has the wrong size", path.string())
+    );
+  }
+
+  mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    mapping = nullptr;
+    throw std::runtime_error(
+        std::format("Failed to map book {}", path.string())
+    );
+  }
+  mapping_size = size;
+
+  FileHeader header{};
+  std::memcpy(&header, mapping, sizeof(header));
+  if (header.magic != MAGIC || header.version != VERSION) {
+    ::munmap(mapping, mapping_size);
+    mapping = nullptr;
+    throw std::runtime_error(
+        std::format("Book {} has an unknown format", path.string())
+    );
+  }
+
+  // lookups jump around the whole file
+  ::madvise(mapping, mapping_size, MADV_RANDOM);
+
+  entries = {
+      reinterpret_cast<const BookEntry *>(
+          static_cast<const char *>(mapping) + sizeof(FileHeader)
+      ),
+      (size - sizeof(FileHeader)) / sizeof(BookEntry)
+  };
+}
+
+OpeningBook::~OpeningBook() {
+  if (mapping != nullptr) {
+    ::munmap(mapping, mapping_size);
+  }
+}
+
+void OpeningBook::write(
+    const std::filesystem::path &path, std::vector<BookEntry> entries
+) {
+  std::ranges::stable_sort(entries, {}, &BookEntry::key);
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  const FileHeader header{.magic = MAGIC, .version = VERSION, .reserved = 0};
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(
+      reinterpret_cast<const char *>(entries.data()),
+      static_cast<std::streamsize>(entries.size() * sizeof(BookEntry))
+  );
+
+  if (!file) {
+    throw std::runtime_error(
+        std::format("Failed to write book {}", path.string())
+    );
+  }
+}
+
+std::span<const BookEntry> OpeningBook::probe(zobrist::Key key) const {
+  // the first entry with a key not below `key` stays within [low, high]
+  std::size_t low = 0;
+  std::size_t high = entries.size();
+
+  while (high - low > INTERPOLATION_LIMIT) {
+    const auto low_key = entries[low].key;
+    const auto high_key = entries[high - 1].key;
+    if (key <= low_key) {
+      high = low;
+      break;
+    }
+    if (key > high_key) {
+      low = high;
+      break;
+    }
+
+    // where `key` would be if the keys were spread evenly, kept off the ends
+    // so that every step shrinks the range
+    const auto fraction = static_cast<long double>(key - low_key) /
+                          static_cast<long double>(high_key - low_key);
+    const auto width = static_cast<long double>(high - 1 - low);
+    const auto guess = low + static_cast<std::size_t>(fraction * width);
+    const auto mid = std::clamp(guess, low + 1, high - 2);
+
+    if (entries[mid].key < key) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+
+  const auto range = entries.subspan(low, high - low);
+  const auto first =
+      low + static_cast<std::size_t>(
+                std::ranges::lower_bound(range, key, {}, &BookEntry::key) -
+                range.begin()
+            );
+
+  auto last = first;
+  while (last < entries.size() && entries[last].key == key) {
+    ++last;
+  }
+
+  return entries.subspan(first, last - first);
+}
+
+std::optional<Move>
+OpeningBook::best_move(const Board &board, Player player) const {
+  const auto candidates = probe(board.hash(player));
+  if (candidates.empty()) {
+    return std::nullopt;
+  }
+
+  return std::ranges::max(candidates, {}, &BookEntry::weight).move();
+}
+
+} // namespace hive::engine
@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <engine/parallel_search.h>
+#include <stop_token>
+#include <thread>
+#include <utility>
+
+namespace hive::engine {
+
+ParallelSearch::ParallelSearch(
+    const Evaluator &evaluator, TranspositionTable &table, std::size_t threads
+)
+    : table(&table) {
+  if (threads == 0) {
+    threads = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+
+  searches.reserve(threads);
+  for (std::size_t i = 0; i < threads; ++i) {
+    searches.emplace_back(evaluator, table);
+  }
+}
+
+SearchResult ParallelSearch::run(
+    const Board &board, Player player, const SearchLimits &limits
+) {
+  table->new_search();
+
+  std::vector<SearchResult> results(searches.size());
+
+  {
+    std::vector<std::jthread> helpers;
+    helpers.reserve(searches.size() - 1);
+
+    for (std::size_t i = 1; i < searches.size(); ++i) {
+      helpers.emplace_back([&, i](std::stop_token stop) {
+        // every other helper skips the first depth
+        results[i] = searches[i].run(
+            board, player, limits, std::move(stop), 1 + (i % 2)
+        );
+      });
+    }
+
+    results[0] = searches[0].run(board, player, limits);
+
+    for (auto &helper : helpers) {
+      helper.request_stop();
+    }
+  } // the helpers are joined here
+
+  // the deepest finished iteration wins, the main thread on ties
+  auto best = results[0];
+  std::size_t nodes = 0;
+
+  for (const auto &result : results) {
+    nodes += result.nodes;
+    if (result.depth > best.depth && result.best_move) {
+      best = result;
+    }
+  }
+
+  best.nodes = nodes;
+  return best;
+}
+
+} // namespace hive::engine
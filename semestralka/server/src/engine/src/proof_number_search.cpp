@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <engine/proof_number_search.h>
+#include <hive/move_list.h>
+#include <limits>
+
+namespace hive::engine {
+
+namespace {
+
+constexpr std::uint32_t INF = std::numeric_limits<std::uint32_t>::max();
+
+std::uint32_t saturating_add(std::uint32_t lhs, std::uint32_t rhs) {
+  return lhs > INF - rhs ? INF : lhs + rhs;
+}
+
+/// The same position with a different number of plies left is a different
+/// problem.
+zobrist::Key node_key(zobrist::Key hash, std::size_t plies) {
+  return hash ^ zobrist::mix(plies);
+}
+
+/// Whether `player` to move has reached their goal, empty while the game
+/// goes on and there are plies left. The attacker's goal is surrounding the
+/// defender's queen, the defender's goal is preventing that.
+std::optional<bool> goal_reached(
+    const Board &board, Player player, Player attacker, std::size_t plies
+) {
+  const auto result = board.game_result();
+  const bool won = result == (attacker == Player::White ? GameResult::WhiteWon
+                                                        : GameResult::BlackWon);
+
+  if (result != GameResult::InProgress || plies == 0) {
+    return (player == attacker) == won;
+  }
+  return std::nullopt;
+}
+
+} // namespace
+
+ProofNumberSearch::ProofNumberSearch(std::size_t table_megabytes) {
+  const auto entries = std::max<std::size_t>(
+      (table_megabytes << 20U) / sizeof(Entry), std::size_t{1}
+  );
+  table.resize(std::bit_floor(entries));
+}
+
+SolverResult ProofNumberSearch::solve(
+    Board board, Player attacker, const SolverLimits &limits
+) {
+  // the copy keeps the listener of the caller's board, which must not see
+  // the moves tried by the search
+  board.set_listener(nullptr);
+
+  std::ranges::fill(table, Entry{});
+  this->attacker = attacker;
+  root_plies = limits.max_plies;
+  root_move = std::nullopt;
+  nodes = 0;
+  max_nodes = limits.max_nodes;
+  aborted = false;
+
+  const auto root = mid(board, attacker, root_plies, INF, INF);
+
+  SolverResult result;
+  result.nodes = nodes;
+
+  if (aborted) {
+    return result;
+  }
+
+  if (root.phi == 0) {
+    result.proof = Proof::Win;
+    result.move = root_move;
+  } else if (root.delta == 0) {
+    result.proof = Proof::NoWin;
+  }
+  return result;
+}
+
+ProofNumberSearch::Numbers ProofNumberSearch::mid(
+    Board &board,
+    Player player,
+    std::size_t plies,
+    std::uint32_t max_phi,
+    std::uint32_t max_delta
+) {
+  if (++nodes > max_nodes) {
+    aborted = true;
+    return {.phi = 1, .delta = 1};
+  }
+
+  const auto key = node_key(board.hash(player), plies);
+
+  if (const auto reached = goal_reached(board, player, attacker, plies)) {
+    const auto numbers = *reached ? Numbers{.phi = 0, .delta = INF}
+                                  : Numbers{.phi = INF, .delta = 0};
+    store({.key = key, .phi = numbers.phi, .delta = numbers.delta});
+    return numbers;
+  }
+
+  MoveList moves;
+  board.moves_for_player(player, moves);
+
+  // a player without a move passes, which is the only child then
+  const auto count = std::max<std::size_t>(moves.size(), 1);
+  const auto next = opponent(player);
+
+  // the table only seeds the numbers of the children, sibling entries may
+  // evict each other and re-reading them could loop forever
+  std::array<Numbers, MoveList::CAPACITY> children;
+  for (std::size_t i = 0; i < count; ++i) {
+    std::optional<Board::UndoInfo> undo;
+    if (!moves.empty()) {
+      undo = board.make_move(moves[i], player);
+    }
+
+    if (const auto reached = goal_reached(board, next, attacker, plies - 1)) {
+      children[i] = *reached ? Numbers{.phi = 0, .delta = INF}
+                             : Numbers{.phi = INF, .delta = 0};
+    } else if (const auto *entry =
+                   find(node_key(board.hash(next), plies - 1))) {
+      children[i] = {.phi = entry->phi, .delta = entry->delta};
+    } else {
+      children[i] = {.phi = 1, .delta = 1};
+    }
+
+    if (undo) {
+      board.unmake_move(*undo);
+    }
+  }
+
+  while (true) {
+    // a node is proven by one disproven child and disproven when all of its
+    // children are proven
+    std::uint32_t phi = INF;
+    std::uint32_t delta = 0;
+    std::uint32_t second_delta = INF;
+    std::size_t best = 0;
+
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto [child_phi, child_delta] = children[i];
+
+      if (child_delta < phi) {
+        second_delta = phi;
+        phi = child_delta;
+        best = i;
+      } else if (child_delta < second_delta) {
+        second_delta = child_delta;
+      }
+      delta = saturating_add(delta, child_phi);
+    }
+
+    store({.key = key, .phi = phi, .delta = delta});
+
+    if (phi >= max_phi || delta >= max_delta || aborted) {
+      if (plies == root_plies && phi == 0 && !moves.empty()) {
+        root_move = moves[best];
+      }
+      return {.phi = phi, .delta = delta};
+    }
+
+    const auto best_phi = children[best].phi;
+
+    // the child may grow until the node's delta reaches its threshold, or
+    // until it is no longer the most promising child
+    const auto child_max_phi =
+        max_delta == INF ? INF : max_delta - delta + best_phi;
+    const auto child_max_delta =
+        std::min(max_phi, saturating_add(second_delta, 1));
+
+    std::optional<Board::UndoInfo> undo;
+    if (!moves.empty()) {
+      undo = board.make_move(moves[best], player);
+    }
+    children[best] =
+        mid(board, next, plies - 1, child_max_phi, child_max_delta);
+    if (undo) {
+      board.unmake_move(*undo);
+    }
+  }
+}
+
+const ProofNumberSearch::Entry *
+ProofNumberSearch::find(zobrist::Key key) const {
+  const auto &entry = table[key & (table.size() - 1)];
+  return entry.key == key ? &entry : nullptr;
+}
+
+void ProofNumberSearch::store(const Entry &entry) {
+  table[entry.key & (table.size() - 1)] = entry;
+}
+
+} // namespace hive::engine
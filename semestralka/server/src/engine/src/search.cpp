@@ -0,0 +1,363 @@
+#include <algorithm>
+#include <cstdlib>
+#include <engine/search.h>
+#include <limits>
+#include <utility>
+
+namespace hive::engine {
+
+namespace {
+
+/// The clock is read once per this many nodes.
+constexpr std::size_t TIME_CHECK_INTERVAL = 2048;
+
+constexpr Score BEST_MOVE_KEY = std::numeric_limits<Score>::max();
+constexpr Score FIRST_KILLER_KEY = BEST_MOVE_KEY - 1;
+constexpr Score SECOND_KILLER_KEY = BEST_MOVE_KEY - 2;
+/// History scores are halved when one of them gets past this, which keeps
+/// them below the killer keys and lets old entries fade out.
+constexpr Score HISTORY_LIMIT = 1 << 24;
+
+constexpr std::size_t HISTORY_CELLS = 32 * 32;
+constexpr std::size_t HISTORY_SIZE = 2 * 2 * NUMBER_OF_PIECES * HISTORY_CELLS;
+
+/// Slot of a move in the history table. Destinations are folded into a
+/// 32×32 window, which is wider than any hive.
+std::size_t history_index(Move move, Player player) {
+  const auto placement = static_cast<std::size_t>(move.from == move.to);
+  const auto cell = ((static_cast<std::uint32_t>(move.to.q) % 32) * 32) +
+                    (static_cast<std::uint32_t>(move.to.p) % 32);
+
+  const auto kind = static_cast<std::size_t>(move.piece_kind);
+  const auto side = static_cast<std::size_t>(player);
+
+  return ((((side * 2) + placement) * NUMBER_OF_PIECES + kind) *
+          HISTORY_CELLS) +
+         cell;
+}
+
+/// Swap the move with the highest key among `order[from..count)` to `from`.
+void pick_next(
+    std::array<std::uint16_t, MoveList::CAPACITY> &order,
+    const std::array<Score, MoveList::CAPACITY> &scores,
+    std::size_t from,
+    std::size_t count
+) {
+  auto best = from;
+  for (auto i = from + 1; i < count; ++i) {
+    if (scores[order[i]] > scores[order[best]]) {
+      best = i;
+    }
+  }
+  std::swap(order[from], order[best]);
+}
+
+/// Score of a finished game for `player`, empty while the game goes on.
+std::optional<Score>
+terminal_score(const Board &board, Player player, std::size_t ply) {
+  const auto result = board.game_result();
+  if (result == GameResult::InProgress) {
+    return std::nullopt;
+  }
+  if (result == GameResult::Draw) {
+    return 0;
+  }
+
+  const auto won =
+      player == Player::White ? GameResult::WhiteWon : GameResult::BlackWon;
+  return result == won ? WIN - static_cast<Score>(ply)
+                       : -WIN + static_cast<Score>(ply);
+}
+
+/// Scores of forced wins count the plies from the root, the table stores them
+/// relative to the node instead.
+Score to_table(Score score, std::size_t ply) {
+  if (score > WIN_THRESHOLD) {
+    return score + static_cast<Score>(ply);
+  }
+  if (score < -WIN_THRESHOLD) {
+    return score - static_cast<Score>(ply);
+  }
+  return score;
+}
+
+Score from_table(Score score, std::size_t ply) {
+  if (score > WIN_THRESHOLD) {
+    return score - static_cast<Score>(ply);
+  }
+  if (score < -WIN_THRESHOLD) {
+    return score + static_cast<Score>(ply);
+  }
+  return score;
+}
+
+} // namespace
+
+Search::Search(const Evaluator &evaluator, TranspositionTable &table)
+    : evaluator(&evaluator), table(&table), history(HISTORY_SIZE) {}
+
+SearchResult Search::run(
+    Board board,
+    Player player,
+    const SearchLimits &limits,
+    std::stop_token stop,
+    std::size_t first_depth
+) {
+  deadline = Clock::now() + limits.time_budget;
+  stop_token = std::move(stop);
+  stopped = false;
+  nodes = 0;
+
+  killers = {};
+  std::ranges::fill(history, 0);
+
+  const auto listener = evaluator->attach(board);
+
+  SearchResult result;
+  const auto max_depth = std::min(limits.max_depth, MAX_PLY);
+
+  // a move from an earlier search, e.g. one expecting this position
+  if (const auto entry = table->probe(board.hash(player))) {
+    result.best_move = entry->move;
+  }
+
+  for (auto depth = std::max(first_depth, std::size_t{1}); depth <= max_depth;
+       ++depth) {
+    const auto [move, score] =
+        search_root(board, player, depth, result.best_move);
+
+    if (stopped) {
+      // an unfinished iteration is only used when nothing better is known
+      if (result.depth == 0 && move) {
+        result.best_move = move;
+        result.score = score;
+      }
+      break;
+    }
+
+    result.best_move = move;
+    result.score = score;
+    result.depth = depth;
+
+    table->store(
+        board.hash(player),
+        {.move = move,
+         .score = score,
+         .depth = static_cast<std::uint8_t>(depth),
+         .bound = Bound::Exact}
+    );
+
+    if (!move || std::abs(score) > WIN_THRESHOLD) {
+      break;
+    }
+  }
+
+  result.nodes = nodes;
+  return result;
+}
+
+std::pair<std::optional<Move>, Score> Search::search_root(
+    Board &board,
+    Player player,
+    std::size_t depth,
+    std::optional<Move> previous_best
+) {
+  MoveList moves;
+  board.moves_for_player(player, moves);
+
+  if (moves.empty()) {
+    const auto score =
+        -negamax(board, opponent(player), depth - 1, 1, -WIN, WIN);
+    return {std::nullopt, score};
+  }
+
+  std::array<Score, MoveList::CAPACITY> scores;
+  score_moves(moves, player, 0, previous_best, scores);
+
+  std::array<std::uint16_t, MoveList::CAPACITY> order;
+  for (std::size_t i = 0; i < moves.size(); ++i) {
+    order[i] = static_cast<std::uint16_t>(i);
+  }
+
+  std::optional<Move> best_move;
+  Score alpha = -WIN;
+
+  for (std::size_t i = 0; i < moves.size(); ++i) {
+    pick_next(order, scores, i, moves.size());
+    const auto move = moves[order[i]];
+
+    const auto undo = board.make_move(move, player);
+    const auto score =
+        -negamax(board, opponent(player), depth - 1, 1, -WIN, -alpha);
+    board.unmake_move(undo);
+
+    // the first move is searched even when out of time, so that there is
+    // always some move to play
+    if (stopped && best_move) {
+      break;
+    }
+
+    if (!best_move || score > alpha) {
+      alpha = score;
+      best_move = move;
+    }
+  }
+
+  return {best_move, alpha};
+}
+
+Score Search::negamax(
+    Board &board,
+    Player player,
+    std::size_t depth,
+    std::size_t ply,
+    Score alpha,
+    Score beta
+) {
+  ++nodes;
+  check_stop();
+  if (stopped) {
+    return 0;
+  }
+
+  if (const auto score = terminal_score(board, player, ply)) {
+    return *score;
+  }
+
+  if (depth == 0 || ply >= MAX_PLY) {
+    return evaluator->evaluate(board, player);
+  }
+
+  const auto key = board.hash(player);
+  std::optional<Move> table_move;
+
+  if (const auto entry = table->probe(key)) {
+    table_move = entry->move;
+
+    if (entry->depth >= depth) {
+      const auto score = from_table(entry->score, ply);
+
+      if (entry->bound == Bound::Exact ||
+          (entry->bound == Bound::Lower && score >= beta) ||
+          (entry->bound == Bound::Upper && score <= alpha)) {
+        return score;
+      }
+    }
+  }
+
+  MoveList moves;
+  board.moves_for_player(player, moves);
+
+  // a player without moves passes
+  if (moves.empty()) {
+    return -negamax(board, opponent(player), depth - 1, ply + 1, -beta, -alpha);
+  }
+
+  std::array<Score, MoveList::CAPACITY> scores;
+  score_moves(moves, player, ply, table_move, scores);
+
+  std::array<std::uint16_t, MoveList::CAPACITY> order;
+  for (std::size_t i = 0; i < moves.size(); ++i) {
+    order[i] = static_cast<std::uint16_t>(i);
+  }
+
+  const auto original_alpha = alpha;
+  Score best = -WIN;
+  std::optional<Move> best_move;
+
+  for (std::size_t i = 0; i < moves.size(); ++i) {
+    pick_next(order, scores, i, moves.size());
+    const auto move = moves[order[i]];
+
+    const auto undo = board.make_move(move, player);
+    const auto score =
+        -negamax(board, opponent(player), depth - 1, ply + 1, -beta, -alpha);
+    board.unmake_move(undo);
+
+    if (stopped) {
+      return 0;
+    }
+
+    if (score > best) {
+      best = score;
+      best_move = move;
+    }
+    alpha = std::max(alpha, score);
+
+    if (alpha >= beta) {
+      store_cutoff(move, player, depth, ply);
+      break;
+    }
+  }
+
+  Bound bound = Bound::Exact;
+  if (best <= original_alpha) {
+    // all moves failed low, none of them is known to be best
+    bound = Bound::Upper;
+    best_move.reset();
+  } else if (best >= beta) {
+    bound = Bound::Lower;
+  }
+
+  table->store(
+      key,
+      {.move = best_move,
+       .score = to_table(best, ply),
+       .depth = static_cast<std::uint8_t>(depth),
+       .bound = bound}
+  );
+
+  return best;
+}
+
+void Search::score_moves(
+    const MoveList &moves,
+    Player player,
+    std::size_t ply,
+    std::optional<Move> best,
+    std::array<Score, MoveList::CAPACITY> &scores
+) const {
+  const auto &[first_killer, second_killer] = killers[ply];
+
+  for (std::size_t i = 0; i < moves.size(); ++i) {
+    const auto move = moves[i];
+
+    if (move == best) {
+      scores[i] = BEST_MOVE_KEY;
+    } else if (move == first_killer) {
+      scores[i] = FIRST_KILLER_KEY;
+    } else if (move == second_killer) {
+      scores[i] = SECOND_KILLER_KEY;
+    } else {
+      scores[i] = history[history_index(move, player)];
+    }
+  }
+}
+
+void Search::store_cutoff(
+    Move move, Player player, std::size_t depth, std::size_t ply
+) {
+  auto &[first_killer, second_killer] = killers[ply];
+  if (move != first_killer) {
+    second_killer = first_killer;
+    first_killer = move;
+  }
+
+  auto &entry = history[history_index(move, player)];
+  entry += static_cast<Score>(depth * depth);
+
+  if (entry > HISTORY_LIMIT) {
+    for (auto &value : history) {
+      value /= 2;
+    }
+  }
+}
+
+void Search::check_stop() {
+  if (nodes % TIME_CHECK_INTERVAL == 0 &&
+      (stop_token.stop_requested() || Clock::now() >= deadline)) {
+    stopped = true;
+  }
+}
+
+} // namespace hive::engine
@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <engine/transposition_table.h>
+#include <limits>
+#include <new>
+#include <sys/mman.h>
+
+namespace hive::engine {
+
+namespace {
+
+constexpr std::size_t HUGE_PAGE_SIZE = std::size_t{2} << 20U;
+
+// layout of the data word
+constexpr unsigned MOVE_BITS = 36;
+constexpr unsigned SCORE_SHIFT = 36;
+constexpr unsigned DEPTH_SHIFT = 52;
+constexpr unsigned BOUND_SHIFT = 59;
+constexpr unsigned GENERATION_SHIFT = 61;
+
+constexpr std::uint64_t HAS_MOVE = std::uint64_t{1} << 35U;
+constexpr std::int32_t COORDINATE_LIMIT = 128;
+
+bool fits(Coordinate coordinate) {
+  return coordinate >= -COORDINATE_LIMIT && coordinate < COORDINATE_LIMIT;
+}
+
+/// Moves with all coordinates in [-128, 128) take 36 bits, other moves are
+/// not stored.
+std::uint64_t pack_move(const std::optional<Move> &move) {
+  if (!move || !fits(move->from.p) || !fits(move->from.q) ||
+      !fits(move->to.p) || !fits(move->to.q)) {
+    return 0;
+  }
+
+  const auto byte = [](Coordinate coordinate) {
+    return std::uint64_t{static_cast<std::uint8_t>(coordinate)};
+  };
+
+  return byte(move->from.p) | (byte(move->from.q) << 8U) |
+         (byte(move->to.p) << 16U) | (byte(move->to.q) << 24U) |
+         (std::uint64_t{static_cast<std::uint8_t>(move->piece_kind)} << 32U) |
+         HAS_MOVE;
+}
+
+std::optional<Move> unpack_move(std::uint64_t data) {
+  if ((data & HAS_MOVE) == 0) {
+    return std::nullopt;
+  }
+
+  const auto coordinate = [data](unsigned shift) {
+    return static_cast<Coordinate>(static_cast<std::int8_t>(data >> shift));
+  };
+
+  return Move{
+      .from = {.p = coordinate(0), .q = coordinate(8)},
+      .to = {.p = coordinate(16), .q = coordinate(24)},
+      .piece_kind = static_cast<PieceKind>((data >> 32U) & 0b111U)
+  };
+}
+
+std::uint64_t pack(const TableEntry &entry, std::uint8_t generation) {
+  const auto score = static_cast<std::uint16_t>(entry.score);
+  return pack_move(entry.move) | (std::uint64_t{score} << SCORE_SHIFT) |
+         (std::uint64_t{entry.depth & 0x7FU} << DEPTH_SHIFT) |
+         (std::uint64_t{static_cast<std::uint8_t>(entry.bound)}
+          << BOUND_SHIFT) |
+         (std::uint64_t{generation} << GENERATION_SHIFT);
+}
+
+TableEntry unpack(std::uint64_t data) {
+  return {
+      .move = unpack_move(data & ((std::uint64_t{1} << MOVE_BITS) - 1)),
+      .score = static_cast<std::int16_t>(data >> SCORE_SHIFT),
+      .depth = static_cast<std::uint8_t>((data >> DEPTH_SHIFT) & 0x7FU),
+      .bound = static_cast<Bound>((data >> BOUND_SHIFT) & 0b11U),
+  };
+}
+
+std::uint8_t generation_of(std::uint64_t data) {
+  return static_cast<std::uint8_t>(data >> GENERATION_SHIFT);
+}
+
+std::uint64_t load(std::uint64_t &word) {
+  return std::atomic_ref(word).load(std::memory_order_relaxed);
+}
+
+void save(std::uint64_t &word, std::uint64_t value) {
+  std::atomic_ref(word).store(value, std::memory_order_relaxed);
+}
+
+} // namespace
+
+TranspositionTable::TranspositionTable(std::size_t megabytes) {
+  const auto bytes = megabytes << 20U;
+  bucket_count =
+      std::bit_floor(std::max(bytes / sizeof(Bucket), std::size_t{1}));
+
+  const auto table_bytes = bucket_count * sizeof(Bucket);
+  allocated_bytes =
+      (table_bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+
+  void *memory = MAP_FAILED;
+
+#ifdef MAP_HUGETLB
+  // explicitly reserved huge pages, populated right away
+  memory = mmap(
+      nullptr,
+      allocated_bytes,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE,
+      -1,
+      0
+  );
+  huge_pages = memory != MAP_FAILED;
+#endif
+
+  if (memory == MAP_FAILED) {
+    memory = mmap(
+        nullptr,
+        allocated_bytes,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        -1,
+        0
+    );
+
+    if (memory == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+
+#ifdef MADV_HUGEPAGE
+    // transparent huge pages, if enabled
+    huge_pages = madvise(memory, allocated_bytes, MADV_HUGEPAGE) == 0;
+#endif
+
+    // fault the pages in now instead of during the search
+    std::memset(memory, 0, allocated_bytes);
+  }
+
+  buckets = static_cast<Bucket *>(memory);
+}
+
+TranspositionTable::~TranspositionTable() {
+  munmap(buckets, allocated_bytes);
+}
+
+void TranspositionTable::clear() {
+  std::memset(static_cast<void *>(buckets), 0, bucket_count * sizeof(Bucket));
+  generation = 0;
+}
+
+std::optional<TableEntry> TranspositionTable::probe(zobrist::Key key) const {
+  for (auto &slot : bucket_for(key).slots) {
+    const auto data = load(slot.data);
+    const auto check = load(slot.check);
+
+    if ((check ^ data) == key) {
+      auto entry = unpack(data);
+      if (entry.bound == Bound::None) {
+        return std::nullopt;
+      }
+      return entry;
+    }
+  }
+
+  return std::nullopt;
+}
+
+void TranspositionTable::store(zobrist::Key key, const TableEntry &entry) {
+  auto &bucket = bucket_for(key);
+
+  // overwrite the position itself if present, otherwise the least valuable
+  // entry: shallow and from old searches
+  auto *target = &bucket.slots[0];
+  int target_value = 0;
+
+  for (auto &slot : bucket.slots) {
+    const auto data = load(slot.data);
+
+    if ((load(slot.check) ^ data) == key) {
+      // keep the move of an earlier search of the position if this one
+      // didn't find any
+      auto updated = entry;
+      if (!updated.move) {
+        updated.move = unpack(data).move;
+      }
+
+      const auto packed = pack(updated, generation);
+      save(slot.data, packed);
+      save(slot.check, key ^ packed);
+      return;
+    }
+
+    const auto stored = unpack(data);
+    const auto age =
+        (generation + GENERATIONS - generation_of(data)) % GENERATIONS;
+    const int value = stored.bound == Bound::None
+                          ? std::numeric_limits<int>::min()
+                          : stored.depth - (4 * age);
+
+    if (&slot == &bucket.slots[0] || value < target_value) {
+      target = &slot;
+      target_value = value;
+    }
+  }
+
+  const auto packed = pack(entry, generation);
+  save(target->data, packed);
+  save(target->check, key ^ packed);
+}
+
+} // namespace hive::engine
@@ -0,0 +1,323 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <hive/grid.h>
+#include <hive/types.h>
+#include <optional>
+
+namespace hive {
+
+/// One bit per cell of `Grid`, bit `i` corresponds to grid index `i`.
+///
+/// Moving every cell one step in a direction is a shift of the whole bitboard
+/// by the neighbor offset of that direction. Rows wrap into each other, which
+/// is fine as long as the shifted cells keep off the edges, which `Grid`
+/// guarantees for cells around the hive. All operations are plain loops over
+/// the words, so they vectorize well (four AVX2 registers per bitboard).
+class Bitboard {
+public:
+  using Word = std::uint64_t;
+  static constexpr std::size_t WORD_BITS = 64;
+  static constexpr std::size_t WORDS = grid::SIZE / WORD_BITS;
+
+  constexpr Bitboard() = default;
+
+  [[nodiscard]] static constexpr Bitboard single(grid::Index idx) {
+    Bitboard result;
+    result.set(idx);
+    return result;
+  }
+
+  constexpr void set(grid::Index idx) {
+    words[idx / WORD_BITS] |= Word{1} << (idx % WORD_BITS);
+  }
+
+  constexpr void reset(grid::Index idx) {
+    words[idx / WORD_BITS] &= ~(Word{1} << (idx % WORD_BITS));
+  }
+
+  [[nodiscard]] constexpr bool test(grid::Index idx) const {
+    return ((words[idx / WORD_BITS] >> (idx % WORD_BITS)) & 1U) != 0;
+  }
+
+  [[nodiscard]] constexpr bool any() const {
+    Word acc = 0;
+    for (const auto word : words) {
+      acc |= word;
+    }
+    return acc != 0;
+  }
+
+  [[nodiscard]] constexpr std::size_t count() const {
+    std::size_t total = 0;
+    for (const auto word : words) {
+      total += static_cast<std::size_t>(std::popcount(word));
+    }
+    return total;
+  }
+
+  /// Index of the lowest set bit, the bitboard must not be empty.
+  [[nodiscard]] constexpr grid::Index first() const {
+    for (std::size_t i = 0; i < WORDS; ++i) {
+      if (words[i] != 0) {
+        const auto bit = static_cast<std::size_t>(std::countr_zero(words[i]));
+        return static_cast<grid::Index>((i * WORD_BITS) + bit);
+      }
+    }
+    return 0;
+  }
+
+  /// Call `f` with the index of every set bit in increasing order.
+  template <typename F> constexpr void for_each(F &&f) const {
+    for (std::size_t i = 0; i < WORDS; ++i) {
+      auto word = words[i];
+      while (word != 0) {
+        const auto bit = static_cast<std::size_t>(std::countr_zero(word));
+        f(static_cast<grid::Index>((i * WORD_BITS) + bit));
+        word &= word - 1;
+      }
+    }
+  }
+
+  /// Move every bit from index `i` to `i + offset`, bits shifted past either
+  /// end are dropped.
+  [[nodiscard]] constexpr Bitboard shifted(int offset) const {
+    Bitboard result;
+
+    if (offset >= 0) {
+      const auto word_shift = static_cast<std::size_t>(offset) / WORD_BITS;
+      const auto bit_shift = static_cast<std::size_t>(offset) % WORD_BITS;
+
+      for (std::size_t i = word_shift; i < WORDS; ++i) {
+        auto word = words[i - word_shift] << bit_shift;
+        if (bit_shift != 0 && i > word_shift) {
+          word |= words[i - word_shift - 1] >> (WORD_BITS - bit_shift);
+        }
+        result.words[i] = word;
+      }
+    } else {
+      const auto word_shift = static_cast<std::size_t>(-offset) / WORD_BITS;
+      const auto bit_shift = static_cast<std::size_t>(-offset) % WORD_BITS;
+
+      for (std::size_t i = 0; i + word_shift < WORDS; ++i) {
+        auto word = words[i + word_shift] >> bit_shift;
+        if (bit_shift != 0 && i + word_shift + 1 < WORDS) {
+          word |= words[i + word_shift + 1] << (WORD_BITS - bit_shift);
+        }
+        result.words[i] = word;
+      }
+    }
+
+    return result;
+  }
+
+  /// Cells reached by moving every set cell one step in direction `dir`.
+  [[nodiscard]] constexpr Bitboard step(std::size_t dir) const {
+    return shifted(grid::NEIGHBOR_OFFSETS[dir]);
+  }
+
+  /// Union of all six neighbors of the set cells, without the cells
+  /// themselves.
+  [[nodiscard]] constexpr Bitboard neighbors() const {
+    Bitboard result;
+    for (std::size_t dir = 0; dir < DIRECTIONS.size(); ++dir) {
+      result |= step(dir);
+    }
+    return result & ~*this;
+  }
+
+  constexpr Bitboard &operator|=(const Bitboard &other) {
+    for (std::size_t i = 0; i < WORDS; ++i) {
+      words[i] |= other.words[i];
+    }
+    return *this;
+  }
+
+  constexpr Bitboard &operator&=(const Bitboard &other) {
+    for (std::size_t i = 0; i < WORDS; ++i) {
+      words[i] &= other.words[i];
+    }
+    return *this;
+  }
+
+  constexpr Bitboard &operator^=(const Bitboard &other) {
+    for (std::size_t i = 0; i < WORDS; ++i) {
+      words[i] ^= other.words[i];
+    }
+    return *this;
+  }
+
+  [[nodiscard]] constexpr Bitboard operator~() const {
+    Bitboard result;
+    for (std::size_t i = 0; i < WORDS; ++i) {
+      result.words[i] = ~words[i];
+    }
+    return result;
+  }
+
+  [[nodiscard]] friend constexpr Bitboard
+  operator|(Bitboard lhs, const Bitboard &rhs) {
+    return lhs |= rhs;
+  }
+
+  [[nodiscard]] friend constexpr Bitboard
+  operator&(Bitboard lhs, const Bitboard &rhs) {
+    return lhs &= rhs;
+  }
+
+  [[nodiscard]] friend constexpr Bitboard
+  operator^(Bitboard lhs, const Bitboard &rhs) {
+    return lhs ^= rhs;
+  }
+
+  bool operator==(const Bitboard &other) const = default;
+
+private:
+  alignas(32) std::array<Word, WORDS> words{};
+};
+
+/// Bitboard views of a board, kept in sync with its tiles.
+///
+/// Besides the layers of the tiles themselves, every cell counts its
+/// neighbors topped by each player. The counts change only around the tile
+/// whose top piece changed owner, so placement legality stays a lookup.
+///
+/// Every cell also keeps the mask of its occupied neighbors, which indexes
+/// `grid::SLIDE_GATES`. This is the slide graph around the hive shared by all
+/// sliding pieces: taking a piece out to generate its moves patches the masks
+/// of its six neighbors and nothing else.
+struct BoardLayers {
+  /// Tiles with at least one piece.
+  Bitboard occupied;
+  /// Tiles whose top piece belongs to the player.
+  std::array<Bitboard, 2> players;
+  /// Tiles whose top piece is of the given kind.
+  std::array<Bitboard, NUMBER_OF_PIECES> kinds;
+  /// Tiles with a piece on top of another one.
+  Bitboard stacked;
+  /// Empty cells next to the hive.
+  Bitboard frontier;
+  /// Cells next to at least one tile topped by the player.
+  std::array<Bitboard, 2> touching;
+  /// Number of neighbors of every cell topped by the player.
+  std::array<std::array<std::uint8_t, grid::SIZE>, 2> neighbor_counts{};
+  /// Occupied neighbors of every cell, bit `dir` for `DIRECTIONS[dir]`.
+  std::array<std::uint8_t, grid::SIZE> occupancy{};
+
+  [[nodiscard]] const Bitboard &of(Player player) const {
+    return players[static_cast<std::uint8_t>(player)];
+  }
+
+  [[nodiscard]] const Bitboard &of(PieceKind kind) const {
+    return kinds[static_cast<std::uint8_t>(kind)];
+  }
+
+  [[nodiscard]] const Bitboard &touching_of(Player player) const {
+    return touching[static_cast<std::uint8_t>(player)];
+  }
+
+  [[nodiscard]] std::uint8_t
+  neighbor_count(Player player, grid::Index idx) const {
+    return neighbor_counts[static_cast<std::uint8_t>(player)][idx];
+  }
+
+  /// Bit mask of the directions a piece at `idx` can slide to.
+  [[nodiscard]] std::uint8_t slides(grid::Index idx) const {
+    return grid::SLIDE_GATES[occupancy[idx]].slides;
+  }
+
+  /// Flip `idx` in the occupancy masks of its neighbors. Done twice around
+  /// the generation of its moves, this takes the lone piece at `idx` out of
+  /// the slide graph and back without touching anything else.
+  void toggle_occupancy(grid::Index idx) {
+    for (std::size_t dir = 0; dir < DIRECTIONS.size(); ++dir) {
+      occupancy[grid::neighbor(idx, dir)] ^=
+          static_cast<std::uint8_t>(1U << ((dir + 3) % 6));
+    }
+  }
+
+  /// Update all layers at `idx` from the pieces of the tile stored there.
+  void update(grid::Index idx, const auto &tile) {
+    const auto old_owner = owner(idx);
+    const auto new_owner = top_owner(tile);
+
+    occupied.reset(idx);
+    stacked.reset(idx);
+    for (auto &layer : players) {
+      layer.reset(idx);
+    }
+    for (auto &layer : kinds) {
+      layer.reset(idx);
+    }
+
+    if (!tile.empty()) {
+      const auto top = tile.back();
+      occupied.set(idx);
+      players[static_cast<std::uint8_t>(top.owner)].set(idx);
+      kinds[static_cast<std::uint8_t>(top.kind)].set(idx);
+      if (tile.size() > 1) {
+        stacked.set(idx);
+      }
+    }
+
+    if (old_owner != new_owner) {
+      for (std::size_t dir = 0; dir < DIRECTIONS.size(); ++dir) {
+        const auto cell = grid::neighbor(idx, dir);
+        if (old_owner) {
+          count_neighbor(*old_owner, cell, -1);
+        }
+        if (new_owner) {
+          count_neighbor(*new_owner, cell, 1);
+        }
+        if (!old_owner || !new_owner) {
+          // `idx` lies in the opposite direction as seen from `cell`
+          occupancy[cell] ^= static_cast<std::uint8_t>(1U << ((dir + 3) % 6));
+        }
+        update_frontier(cell);
+      }
+    }
+    update_frontier(idx);
+  }
+
+private:
+  [[nodiscard]] static std::optional<Player> top_owner(const auto &tile) {
+    if (tile.empty()) {
+      return std::nullopt;
+    }
+    return tile.back().owner;
+  }
+
+  [[nodiscard]] std::optional<Player> owner(grid::Index idx) const {
+    for (const auto player : {Player::Black, Player::White}) {
+      if (of(player).test(idx)) {
+        return player;
+      }
+    }
+    return std::nullopt;
+  }
+
+  void count_neighbor(Player player, grid::Index idx, int delta) {
+    const auto side = static_cast<std::uint8_t>(player);
+    auto &count = neighbor_counts[side][idx];
+    count = static_cast<std::uint8_t>(count + delta);
+
+    if (count == 0) {
+      touching[side].reset(idx);
+    } else {
+      touching[side].set(idx);
+    }
+  }
+
+  void update_frontier(grid::Index idx) {
+    if (!occupied.test(idx) &&
+        (neighbor_counts[0][idx] != 0 || neighbor_counts[1][idx] != 0)) {
+      frontier.set(idx);
+    } else {
+      frontier.reset(idx);
+    }
+  }
+};
+
+} // namespace hive
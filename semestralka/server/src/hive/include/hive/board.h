@@ -1,34 +1,73 @@
 #pragma once
 
+#include <array>
+#include <bit>
+#include <hive/bitboard.h>
+#include <hive/grid.h>
+#include <hive/move_list.h>
+#include <hive/piece_reserves.h>
+#include <hive/tile_list.h>
+#include <hive/tile_stack.h>
 #include <hive/types.h>
+#include <hive/zobrist.h>
+#include <optional>
 #include <stdexcept>
 #include <utility>
 #include <utils/format.h>
 #include <utils/generator.h>
-#include <vector>
 
 namespace hive {
 
-inline Direction rotate_left(Direction dir) {
+constexpr Direction rotate_left(Direction dir) {
   return {dir.first + dir.second, -dir.first};
 }
-inline Direction rotate_right(Direction dir) {
+constexpr Direction rotate_right(Direction dir) {
   return {-dir.second, dir.first + dir.second};
 }
 
+/// Notified of every piece put on or taken off a board, so that state derived
+/// from the pieces can be updated incrementally. Pieces lifted temporarily by
+/// the move generator are reported too.
+class BoardListener {
+public:
+  BoardListener() = default;
+  BoardListener(const BoardListener &) = default;
+  BoardListener(BoardListener &&) = default;
+  BoardListener &operator=(const BoardListener &) = default;
+  BoardListener &operator=(BoardListener &&) = default;
+
+  virtual ~BoardListener() = default;
+
+  /// `piece` was put on top of the tile at `ptr`.
+  virtual void piece_added(TilePointer ptr, Piece piece) = 0;
+
+  /// The top piece `piece` was taken off the tile at `ptr`.
+  virtual void piece_removed(TilePointer ptr, Piece piece) = 0;
+};
+
 class Board {
 public:
+  /// Takes the top piece off a tile for the lifetime of the object. The
+  /// cached pinned tiles survive the round trip, so generating the moves of
+  /// a piece doesn't force them to be recomputed.
   class LiftPiece {
   private:
     TilePointer ptr;
     Board *board;
+    Bitboard pinned;
+    bool pinned_valid;
     Piece piece;
 
   public:
     LiftPiece(TilePointer ptr, Board *board)
-        : ptr(ptr), board(board), piece(board->remove_piece(ptr)) {}
+        : ptr(ptr), board(board), pinned(board->pinned),
+          pinned_valid(board->pinned_valid), piece(board->remove_piece(ptr)) {}
 
-    ~LiftPiece() { board->add_piece(ptr, piece); }
+    ~LiftPiece() {
+      board->add_piece(ptr, piece);
+      board->pinned = pinned;
+      board->pinned_valid = pinned_valid;
+    }
 
     LiftPiece(const LiftPiece &) = delete;
     LiftPiece(LiftPiece &&) noexcept = default;
@@ -36,8 +75,12 @@ public:
     LiftPiece &operator=(LiftPiece &&) noexcept = default;
   };
 
-  [[nodiscard]] const std::vector<Piece> &get(TilePointer ptr) const {
-    return data.at(ptr);
+  [[nodiscard]] const TileStack &get(TilePointer ptr) const {
+    const auto *tile = data.find(ptr);
+    if (tile == nullptr) {
+      throw std::out_of_range("Position outside of the board");
+    }
+    return *tile;
   }
 
   [[nodiscard]] Piece get_top(TilePointer ptr) const {
@@ -48,17 +91,65 @@ public:
     return pieces.back();
   }
 
-  [[nodiscard]] bool is_empty() const { return data.empty(); }
+  /// Where the first piece of the game is placed by the move generator.
+  static constexpr TilePointer FIRST_PLACEMENT{.p = 0, .q = 0};
+
+  [[nodiscard]] bool is_empty() const { return tile_count == 0; }
   [[nodiscard]] bool is_empty(TilePointer ptr) const {
-    auto it = data.find(ptr);
-    return it == data.end() || it->second.empty();
+    const auto *tile = data.find(ptr);
+    return tile == nullptr || tile->empty();
   }
 
-  [[nodiscard]] bool has_placed(Player player) const;
-  [[nodiscard]] bool has_placed_queen(Player player) const;
+  /// Zobrist hash of the pieces on the board. Kept up to date by every
+  /// change of the board, pieces in reserve follow from the tiles.
+  [[nodiscard]] zobrist::Key hash() const { return key; }
 
+  /// Zobrist hash of the position with `to_move` being the player to move.
+  [[nodiscard]] zobrist::Key hash(Player to_move) const {
+    return to_move == Player::White ? key ^ zobrist::WHITE_TO_MOVE : key;
+  }
+
+  [[nodiscard]] bool has_placed(Player player) const {
+    return !reserves.is_full(player);
+  }
+  [[nodiscard]] bool has_placed_queen(Player player) const {
+    return !reserves.contains(player, PieceKind::Queen);
+  }
+
+  /// Number of occupied cells around the queen of `player`, 0 while the queen
+  /// is not placed. A player whose queen has all six neighbors lost.
+  [[nodiscard]] std::size_t queen_neighbors(Player player) const {
+    return queen_neighbor_counts[static_cast<std::uint8_t>(player)];
+  }
+
+  /// Cell of the queen of `player`, which may be covered by beetles.
+  [[nodiscard]] std::optional<TilePointer> queen_position(Player player) const {
+    return queens[static_cast<std::uint8_t>(player)];
+  }
+
+  /// Whether the game is over and who won, in constant time.
+  [[nodiscard]] GameResult game_result() const {
+    const bool white_lost =
+        queen_neighbors(Player::White) == DIRECTIONS.size();
+    const bool black_lost =
+        queen_neighbors(Player::Black) == DIRECTIONS.size();
+
+    if (white_lost && black_lost) {
+      return GameResult::Draw;
+    }
+    if (white_lost) {
+      return GameResult::BlackWon;
+    }
+    if (black_lost) {
+      return GameResult::WhiteWon;
+    }
+    return GameResult::InProgress;
+  }
+
+  /// Every occupied tile with its top piece, in no particular order.
   [[nodiscard]] std::generator<std::pair<TilePointer, Piece>> pieces() const;
 
+  /// Tiles topped by a piece of `player`, in no particular order.
   [[nodiscard]] std::generator<std::pair<TilePointer, Piece>>
   players_tiles(Player player) const;
 
@@ -69,8 +160,35 @@ public:
   [[nodiscard]]
   std::generator<Move> moves_for_piece(TilePointer pos, Piece piece);
 
-  [[nodiscard]] std::generator<Move>
-  moves_for_player(Player player, PlayerPiecesMap pieces);
+  [[nodiscard]] std::generator<Move> moves_for_player(Player player);
+
+  /// Call `visit(Move)` for every move of `piece` standing at `pos`. Nothing
+  /// is allocated, the piece is lifted only for the duration of the call.
+  template <typename Visitor>
+  void for_each_piece_move(TilePointer pos, Piece piece, Visitor &&visit);
+
+  /// Call `visit(Move)` for every move of the piece of kind `Kind` standing
+  /// at `pos`. With the kind known at compile time the generator of the piece
+  /// is inlined into the caller together with `visit`.
+  template <PieceKind Kind, typename Visitor>
+  void generate(TilePointer pos, Visitor &&visit);
+
+  /// Call `visit(Move)` for every placement from the reserve of `player`
+  /// and every move of the pieces of `player`, without allocating.
+  template <typename Visitor>
+  void for_each_player_move(Player player, Visitor &&visit);
+
+  void moves_for_piece(TilePointer pos, Piece piece, MoveList &moves) {
+    for_each_piece_move(pos, piece, [&moves](Move move) {
+      moves.push_back(move);
+    });
+  }
+
+  void moves_for_player(Player player, MoveList &moves) {
+    for_each_player_move(player, [&moves](Move move) {
+      moves.push_back(move);
+    });
+  }
 
   [[nodiscard]] std::generator<TilePointer> neighbors(TilePointer ptr) const;
 
@@ -85,33 +203,36 @@ public:
 
   [[nodiscard]] std::unordered_set<TilePointer> tiles_around_hive() const;
 
-  bool can_player_move(Player player, TilePointer ptr) {
+  bool can_player_move(Player player, TilePointer ptr) const {
     return !is_empty(ptr) && has_placed_queen(player) &&
            get_top(ptr).owner == player && !moving_breaks_hive(ptr);
   }
 
-  bool can_player_place(Player player, PieceKind kind) const;
+  bool can_player_place(Player player, PieceKind kind) const {
+    return reserves.contains(player, kind);
+  }
 
+  /// Whether `player` may place a piece at `ptr`, by the same rules as the
+  /// move generator.
   bool can_player_place_at(Player player, TilePointer ptr) const;
 
   [[nodiscard]] std::generator<TilePointer>
   valid_placements(Player player) const;
 
-  [[nodiscard]] bool moving_breaks_hive(TilePointer ptr);
-
-  [[nodiscard]] std::generator<std::pair<TilePointer, Piece>>
-  moveable_pieces_for(Player player);
+  [[nodiscard]] bool moving_breaks_hive(TilePointer ptr) const;
 
-  [[nodiscard]] bool has_neighbor(TilePointer cell) const;
+  /// Whether `player` may play `move`, exactly when the move generator would
+  /// produce it. Only the one placement or piece is checked, so this is much
+  /// cheaper than generating the moves. Sliding pieces are lifted out of the
+  /// slide graph for the duration of the call.
+  [[nodiscard]] bool is_legal(Move move, Player player);
 
-  [[nodiscard]] bool
-  has_neighbor_in_direction(TilePointer cell, Direction direction) const;
-
-  [[nodiscard]] bool
-  can_move_to(TilePointer from, TilePointer to, bool can_leave) const;
+  /// Tiles whose top piece can't move without splitting the hive. Computed
+  /// in one pass over the hive and cached until the board changes.
+  [[nodiscard]] const Bitboard &pinned_tiles() const;
 
-  [[nodiscard]] std::generator<TilePointer>
-  valid_steps(TilePointer ptr, bool can_leave = false) const;
+  [[nodiscard]] std::generator<std::pair<TilePointer, Piece>>
+  moveable_pieces_for(Player player);
 
   [[nodiscard]] std::generator<Move> queens_moves(TilePointer queen);
 
@@ -125,15 +246,13 @@ public:
 
   void apply_move(Move move, Player player) {
     if (move.from == move.to) {
-      auto &available = player_pieces.at(player).at(move.piece_kind);
-
-      if (available == 0) {
+      if (!reserves.contains(player, move.piece_kind)) {
         throw std::runtime_error("Attempted to add piece when no pieces left");
       }
 
       const auto piece = Piece{.kind = move.piece_kind, .owner = player};
       add_piece(move.from, piece);
-      --available;
+      reserves.take(player, move.piece_kind);
       return;
     }
 
@@ -144,23 +263,352 @@ public:
     add_piece(move.to, piece);
   };
 
-  const std::map<Player, PlayerPiecesMap> &get_player_pieces() const {
-    return player_pieces;
+  /// Everything `unmake_move` needs to take a move back.
+  struct UndoInfo {
+    Move move;
+    Player player;
+    TilePointer origin;
+    Bitboard pinned;
+    bool pinned_valid;
+  };
+
+  /// Play `move` for `player` without validating it, the move is expected to
+  /// come from the move generator. Unlike `apply_move` this never throws on
+  /// an illegal move, so the caller is responsible for legality.
+  UndoInfo make_move(Move move, Player player);
+
+  /// Take back a move played by `make_move`, restoring the tiles, the pieces
+  /// in reserve and the cached state. Moves must be taken back in reverse
+  /// order.
+  void unmake_move(const UndoInfo &undo);
+
+  [[nodiscard]] const PieceReserves &get_reserves() const { return reserves; }
+
+  /// Pieces in reserve of both players as maps, for listing them.
+  [[nodiscard]] std::map<Player, PlayerPiecesMap> get_player_pieces() const {
+    return {
+        {Player::White, reserves.to_map(Player::White)},
+        {Player::Black, reserves.to_map(Player::Black)}
+    };
+  }
+
+  [[nodiscard]] PlayerPiecesMap get_player_pieces(Player player) const {
+    return reserves.to_map(player);
   }
 
+  [[nodiscard]] const BoardLayers &get_layers() const { return layers; }
+
+  /// Report the changes of the pieces to `listener`, or to no one when null.
+  /// The listener is not owned and copies of the board report to the same
+  /// listener, so a copy meant to diverge needs a listener of its own.
+  void set_listener(BoardListener *listener) { this->listener = listener; }
+
+  [[nodiscard]] BoardListener *get_listener() const { return listener; }
+
 private:
-  std::unordered_map<TilePointer, std::vector<Piece>> data;
+  /// Takes the lone piece at a tile out of the slide graph for the lifetime
+  /// of the object, which is all the sliding pieces need to generate their
+  /// moves. Unlike `LiftPiece`, the rest of the board doesn't change.
+  class LiftSlider {
+  private:
+    grid::Index idx;
+    BoardLayers *layers;
+
+  public:
+    LiftSlider(grid::Index idx, BoardLayers *layers)
+        : idx(idx), layers(layers) {
+      layers->toggle_occupancy(idx);
+    }
 
-  static const PlayerPiecesMap DEFAULT_PLAYER_PIECES;
+    ~LiftSlider() { layers->toggle_occupancy(idx); }
 
-  std::map<Player, PlayerPiecesMap> player_pieces{
-      {Player::White, DEFAULT_PLAYER_PIECES},
-      {Player::Black, DEFAULT_PLAYER_PIECES}
+    LiftSlider(const LiftSlider &) = delete;
+    LiftSlider(LiftSlider &&) = delete;
+    LiftSlider &operator=(const LiftSlider &) = delete;
+    LiftSlider &operator=(LiftSlider &&) = delete;
   };
 
+  Grid<TileStack> data;
+  std::size_t tile_count = 0;
+  BoardLayers layers;
+  zobrist::Key key = 0;
+  BoardListener *listener = nullptr;
+
+  /// Where the queens are and how many occupied neighbors they have, kept up
+  /// to date by `add_piece` and `remove_piece`.
+  std::array<std::optional<TilePointer>, 2> queens;
+  std::array<std::uint8_t, 2> queen_neighbor_counts{};
+
+  /// Tiles topped by each player, so that iterating the pieces of a player
+  /// doesn't scan the whole grid.
+  std::array<TileList, 2> top_tiles;
+
+  mutable Bitboard pinned;
+  mutable bool pinned_valid = false;
+
+  PieceReserves reserves;
+
+  [[nodiscard]] bool is_empty(grid::Index idx) const {
+    return data[idx].empty();
+  }
+
+  void rebuild_layers();
+
+  /// Add `delta` to the neighbor counts of the queens next to `ptr`, whose
+  /// tile just became occupied or empty.
+  void count_queen_neighbors(TilePointer ptr, int delta);
+
+  [[nodiscard]] Bitboard articulation_points() const;
+
+  [[nodiscard]] bool has_neighbor(grid::Index cell) const;
+
+  /// Cells reachable from `start` by any number of slides, without `start`
+  /// itself. The piece at `start` has to be taken out of the slide graph.
+  /// The walk stops once it gets to `until`, leaving the rest unexplored.
+  [[nodiscard]] Bitboard slide_reach(
+      grid::Index start, std::optional<grid::Index> until = std::nullopt
+  ) const;
+
+  /// Whether the spider at `start` ends a path of three slides at `target`.
+  /// The spider has to be taken out of the slide graph.
+  [[nodiscard]] bool
+  spider_reaches(grid::Index start, grid::Index target) const;
+
+  /// Empty cells where `player` may place a new piece, the board must not be
+  /// empty.
+  [[nodiscard]] Bitboard placement_cells(Player player) const;
+
+  template <typename Visitor>
+  void for_each_queen_move(TilePointer queen, Visitor &&visit);
+
+  template <typename Visitor>
+  void for_each_beetle_move(TilePointer beetle, Visitor &&visit);
+
+  template <typename Visitor>
+  void for_each_grasshopper_move(TilePointer grasshopper, Visitor &&visit);
+
+  template <typename Visitor>
+  void for_each_spider_move(TilePointer spider, Visitor &&visit);
+
+  template <typename Visitor>
+  void for_each_ant_move(TilePointer ant, Visitor &&visit);
+
   friend std::formatter<Board>;
 };
 
+namespace detail {
+
+/// Call `f` with every direction set in the bit mask `directions`.
+template <typename F> void for_each_direction(std::uint8_t directions, F &&f) {
+  for (unsigned mask = directions; mask != 0; mask &= mask - 1) {
+    f(static_cast<std::size_t>(std::countr_zero(mask)));
+  }
+}
+
+/// Whether `pred` holds for some direction set in the bit mask `directions`,
+/// trying them in order and stopping at the first one it holds for.
+template <typename Pred>
+bool any_direction(std::uint8_t directions, Pred &&pred) {
+  for (unsigned mask = directions; mask != 0; mask &= mask - 1) {
+    if (pred(static_cast<std::size_t>(std::countr_zero(mask)))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace detail
+
+template <typename Visitor>
+void Board::for_each_piece_move(
+    TilePointer pos, Piece piece, Visitor &&visit
+) {
+  switch (piece.kind) {
+  case PieceKind::Queen:
+    return generate<PieceKind::Queen>(pos, visit);
+  case PieceKind::Spider:
+    return generate<PieceKind::Spider>(pos, visit);
+  case PieceKind::Beetle:
+    return generate<PieceKind::Beetle>(pos, visit);
+  case PieceKind::Grasshopper:
+    return generate<PieceKind::Grasshopper>(pos, visit);
+  case PieceKind::Ant:
+    return generate<PieceKind::Ant>(pos, visit);
+  }
+}
+
+template <PieceKind Kind, typename Visitor>
+void Board::generate(TilePointer pos, Visitor &&visit) {
+  if constexpr (Kind == PieceKind::Queen) {
+    for_each_queen_move(pos, visit);
+  } else if constexpr (Kind == PieceKind::Spider) {
+    for_each_spider_move(pos, visit);
+  } else if constexpr (Kind == PieceKind::Beetle) {
+    for_each_beetle_move(pos, visit);
+  } else if constexpr (Kind == PieceKind::Grasshopper) {
+    for_each_grasshopper_move(pos, visit);
+  } else {
+    static_assert(Kind == PieceKind::Ant);
+    for_each_ant_move(pos, visit);
+  }
+}
+
+template <typename Visitor>
+void Board::for_each_player_move(Player player, Visitor &&visit) {
+  std::array<PieceKind, NUMBER_OF_PIECES> kinds{};
+  std::size_t kind_count = 0;
+  for (std::size_t kind = 0; kind < NUMBER_OF_PIECES; ++kind) {
+    kinds[kind_count] = static_cast<PieceKind>(kind);
+    kind_count += reserves.contains(player, kinds[kind_count]) ? 1 : 0;
+  }
+
+  const auto place_at = [&](TilePointer ptr) {
+    for (std::size_t i = 0; i < kind_count; ++i) {
+      visit(make_placement(ptr, kinds[i]));
+    }
+  };
+
+  if (is_empty()) {
+    place_at(FIRST_PLACEMENT);
+    return;
+  }
+
+  placement_cells(player).for_each([&](grid::Index idx) {
+    place_at(data.pointer(idx));
+  });
+
+  if (!has_placed_queen(player)) {
+    return;
+  }
+
+  // generating moves of a beetle lifts it, which invalidates the cache and
+  // reorders the tile list
+  const auto pinned_now = pinned_tiles();
+  const auto tiles = top_tiles[static_cast<std::uint8_t>(player)];
+
+  for (const auto ptr : tiles) {
+    const auto idx = data.index(ptr);
+    if (!pinned_now.test(idx)) {
+      for_each_piece_move(ptr, data[idx].back(), visit);
+    }
+  }
+}
+
+template <typename Visitor>
+void Board::for_each_queen_move(TilePointer queen, Visitor &&visit) {
+  const auto start = data.index(queen);
+
+  // unlike the other pieces, the queen may also step away from the hive as
+  // long as it touches the hive again at the target, where the queen itself
+  // is one of the neighbors
+  auto directions = layers.slides(start);
+  const auto detached = grid::SLIDE_GATES[layers.occupancy[start]].detached;
+  detail::for_each_direction(detached, [&](std::size_t dir) {
+    const auto target = grid::neighbor(start, dir);
+    if (layers.neighbor_count(Player::White, target) +
+            layers.neighbor_count(Player::Black, target) >
+        1) {
+      directions |= static_cast<std::uint8_t>(1U << dir);
+    }
+  });
+
+  detail::for_each_direction(directions, [&](std::size_t dir) {
+    visit(Move{
+        .from = queen,
+        .to = data.pointer(grid::neighbor(start, dir)),
+        .piece_kind = PieceKind::Queen
+    });
+  });
+}
+
+template <typename Visitor>
+void Board::for_each_beetle_move(TilePointer beetle, Visitor &&visit) {
+  const LiftPiece _(beetle, this);
+
+  const auto start = data.index(beetle);
+
+  for (std::size_t dir = 0; dir < DIRECTIONS.size(); ++dir) {
+    const auto target = grid::neighbor(start, dir);
+    if (has_neighbor(target)) {
+      visit(Move{
+          .from = beetle,
+          .to = data.pointer(target),
+          .piece_kind = PieceKind::Beetle
+      });
+    }
+  }
+}
+
+template <typename Visitor>
+void Board::for_each_grasshopper_move(
+    TilePointer grasshopper, Visitor &&visit
+) {
+  const auto start = data.index(grasshopper);
+
+  // jump over the line of pieces in each direction to the first empty cell,
+  // the grasshopper itself is never on the line, so it stays where it is
+  for (std::size_t dir = 0; dir < DIRECTIONS.size(); ++dir) {
+    auto current = grid::neighbor(start, dir);
+    if (is_empty(current)) {
+      continue;
+    }
+
+    while (!is_empty(current)) {
+      current = grid::neighbor(current, dir);
+    }
+
+    visit(Move{
+        .from = grasshopper,
+        .to = data.pointer(current),
+        .piece_kind = PieceKind::Grasshopper
+    });
+  }
+}
+
+template <typename Visitor>
+void Board::for_each_spider_move(TilePointer spider, Visitor &&visit) {
+  const auto start = data.index(spider);
+  const LiftSlider _(start, &layers);
+
+  // every path of exactly three slides that doesn't visit a cell twice
+  Bitboard targets;
+  detail::for_each_direction(layers.slides(start), [&](std::size_t first) {
+    const auto one = grid::neighbor(start, first);
+
+    detail::for_each_direction(layers.slides(one), [&](std::size_t second) {
+      const auto two = grid::neighbor(one, second);
+      if (two == start) {
+        return;
+      }
+
+      detail::for_each_direction(layers.slides(two), [&](std::size_t third) {
+        const auto three = grid::neighbor(two, third);
+        if (three != start && three != one) {
+          targets.set(three);
+        }
+      });
+    });
+  });
+
+  targets.for_each([&](grid::Index idx) {
+    visit(Move{
+        .from = spider, .to = data.pointer(idx), .piece_kind = PieceKind::Spider
+    });
+  });
+}
+
+template <typename Visitor>
+void Board::for_each_ant_move(TilePointer ant, Visitor &&visit) {
+  const auto start = data.index(ant);
+  const LiftSlider _(start, &layers);
+
+  slide_reach(start).for_each([&](grid::Index idx) {
+    visit(Move{
+        .from = ant, .to = data.pointer(idx), .piece_kind = PieceKind::Ant
+    });
+  });
+}
+
 } // namespace hive
 
 template <> struct std::formatter<hive::Board> {
@@ -169,6 +617,15 @@ template <> struct std::formatter<hive::Board> {
   }
 
   static auto format(const hive::Board &obj, std::format_context &ctx) {
-    return std::format_to(ctx.out(), "{}", obj.data);
+    std::format_to(ctx.out(), "{{");
+    bool first = true;
+    for (const auto &[ptr, _] : obj.pieces()) {
+      if (!first) {
+        std::format_to(ctx.out(), ", ");
+      }
+      std::format_to(ctx.out(), "{}: {}", ptr, obj.get(ptr));
+      first = false;
+    }
+    return std::format_to(ctx.out(), "}}");
   }
 };
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <hive/types.h>
+#include <stdexcept>
+
+namespace hive {
+
+namespace grid {
+
+using Index = std::uint16_t;
+
+/// Number of cells along each axis of the grid.
+constexpr Coordinate WIDTH = 32;
+constexpr std::size_t SIZE = static_cast<std::size_t>(WIDTH) * WIDTH;
+
+/// Minimal distance between an occupied cell and the edge of the grid. Move
+/// generation only looks a couple of cells past the hive, so with this margin
+/// all neighbor offsets from cells near the hive stay inside the grid.
+constexpr Coordinate MARGIN = 4;
+
+constexpr int offset(Direction dir) { return (dir.second * WIDTH) + dir.first; }
+
+/// Index offsets of the six neighbors, in the same order as `DIRECTIONS`.
+constexpr std::array<int, 6> NEIGHBOR_OFFSETS{
+    offset(DIRECTIONS[0]),
+    offset(DIRECTIONS[1]),
+    offset(DIRECTIONS[2]),
+    offset(DIRECTIONS[3]),
+    offset(DIRECTIONS[4]),
+    offset(DIRECTIONS[5]),
+};
+
+/// Index of the neighbor of `idx` in the direction `DIRECTIONS[dir]`.
+constexpr Index neighbor(Index idx, std::size_t dir) {
+  return static_cast<Index>(idx + NEIGHBOR_OFFSETS[dir]);
+}
+
+/// Direction obtained by `rotate_left` of `DIRECTIONS[dir]`.
+constexpr std::size_t rotate_left(std::size_t dir) { return (dir + 5) % 6; }
+/// Direction obtained by `rotate_right` of `DIRECTIONS[dir]`.
+constexpr std::size_t rotate_right(std::size_t dir) { return (dir + 1) % 6; }
+
+/// Directions of a slide out of a cell, as bit masks indexed like
+/// `DIRECTIONS`. A step in direction `dir` squeezes between the two cells in
+/// directions `rotate_left(dir)` and `rotate_right(dir)`, which neighbor both
+/// ends of the step.
+struct SlideGates {
+  /// Steps to an empty cell with exactly one of the two cells occupied, the
+  /// piece keeps touching the hive and fits through.
+  std::uint8_t slides = 0;
+  /// Steps to an empty cell with both of the two cells empty, the piece loses
+  /// contact with the hive on the way.
+  std::uint8_t detached = 0;
+};
+
+/// Slide gates of a cell for every 6-bit occupancy mask of its neighbors, bit
+/// `dir` is set when the neighbor in direction `dir` is occupied.
+constexpr std::array<SlideGates, 64> SLIDE_GATES = [] {
+  constexpr unsigned ALL = 0b111111U;
+
+  std::array<SlideGates, 64> gates{};
+  for (unsigned mask = 0; mask <= ALL; ++mask) {
+    // bit `dir` of `left` is the occupancy of `rotate_left(dir)` and so on
+    const auto left = ((mask << 1U) | (mask >> 5U)) & ALL;
+    const auto right = ((mask >> 1U) | (mask << 5U)) & ALL;
+    const auto empty = ~mask & ALL;
+
+    gates[mask] = {
+        .slides = static_cast<std::uint8_t>(empty & (left ^ right)),
+        .detached = static_cast<std::uint8_t>(empty & ~left & ~right),
+    };
+  }
+  return gates;
+}();
+
+} // namespace grid
+
+/// Dense, bounded hex grid of cells indexed by packed (p, q) coordinates.
+///
+/// The grid covers a `WIDTH`×`WIDTH` window of the infinite board starting at
+/// `origin()`. When a cell close to the edge of the window is reserved, the
+/// occupied cells are moved so that the hive is centered again. Coordinates
+/// handed out to callers are absolute, so re-centering is invisible outside
+/// of the grid, only indices change.
+template <typename Cell> class Grid {
+public:
+  [[nodiscard]] TilePointer origin() const { return _origin; }
+
+  [[nodiscard]] bool contains(TilePointer ptr) const {
+    const auto p = ptr.p - _origin.p;
+    const auto q = ptr.q - _origin.q;
+    return p >= 0 && p < grid::WIDTH && q >= 0 && q < grid::WIDTH;
+  }
+
+  /// Index of the cell at `ptr`, which has to be inside the grid.
+  [[nodiscard]] grid::Index index(TilePointer ptr) const {
+    return static_cast<grid::Index>(
+        ((ptr.q - _origin.q) * grid::WIDTH) + (ptr.p - _origin.p)
+    );
+  }
+
+  [[nodiscard]] TilePointer pointer(grid::Index idx) const {
+    return {
+        .p = _origin.p + (idx % grid::WIDTH),
+        .q = _origin.q + (idx / grid::WIDTH)
+    };
+  }
+
+  [[nodiscard]] Cell &operator[](grid::Index idx) { return cells[idx]; }
+  [[nodiscard]] const Cell &operator[](grid::Index idx) const {
+    return cells[idx];
+  }
+
+  /// Cell at `ptr` or `nullptr` when it lies outside of the grid.
+  [[nodiscard]] const Cell *find(TilePointer ptr) const {
+    return contains(ptr) ? &cells[index(ptr)] : nullptr;
+  }
+
+  /// Make sure `ptr` lies at least `MARGIN` cells from the edge of the grid,
+  /// re-centering the grid around the occupied cells and `ptr` if needed.
+  ///
+  /// @return whether the grid was re-centered and indices have changed
+  bool reserve(TilePointer ptr) {
+    if (in_margin(ptr)) {
+      return false;
+    }
+
+    recenter(ptr);
+    return true;
+  }
+
+private:
+  std::array<Cell, grid::SIZE> cells{};
+  TilePointer _origin{.p = -grid::WIDTH / 2, .q = -grid::WIDTH / 2};
+
+  [[nodiscard]] bool in_margin(TilePointer ptr) const {
+    const auto p = ptr.p - _origin.p;
+    const auto q = ptr.q - _origin.q;
+    return p >= grid::MARGIN && p < grid::WIDTH - grid::MARGIN &&
+           q >= grid::MARGIN && q < grid::WIDTH - grid::MARGIN;
+  }
+
+  void recenter(TilePointer ptr) {
+    TilePointer min = ptr;
+    TilePointer max = ptr;
+
+    for (std::size_t idx = 0; idx < grid::SIZE; ++idx) {
+      if (cells[idx].empty()) {
+        continue;
+      }
+
+      const auto cell_ptr = pointer(static_cast<grid::Index>(idx));
+      min = {
+          .p = std::min(min.p, cell_ptr.p), .q = std::min(min.q, cell_ptr.q)
+      };
+      max = {
+          .p = std::max(max.p, cell_ptr.p), .q = std::max(max.q, cell_ptr.q)
+      };
+    }
+
+    // centering rounds, so leave one spare cell on each side
+    constexpr auto max_extent = grid::WIDTH - (2 * grid::MARGIN) - 2;
+    if (max.p - min.p > max_extent || max.q - min.q > max_extent) {
+      throw std::length_error("Hive does not fit into the board grid");
+    }
+
+    const TilePointer new_origin{
+        .p = ((min.p + max.p) / 2) - (grid::WIDTH / 2),
+        .q = ((min.q + max.q) / 2) - (grid::WIDTH / 2)
+    };
+
+    std::array<Cell, grid::SIZE> moved{};
+    for (std::size_t idx = 0; idx < grid::SIZE; ++idx) {
+      if (cells[idx].empty()) {
+        continue;
+      }
+
+      const auto cell_ptr = pointer(static_cast<grid::Index>(idx));
+      const auto new_idx = static_cast<std::size_t>(
+          ((cell_ptr.q - new_origin.q) * grid::WIDTH) +
+          (cell_ptr.p - new_origin.p)
+      );
+      moved[new_idx] = std::move(cells[idx]);
+    }
+
+    cells = std::move(moved);
+    _origin = new_origin;
+  }
+};
+
+} // namespace hive
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <hive/types.h>
+#include <stdexcept>
+
+namespace hive {
+
+/// Fixed-capacity list of moves, meant to live on the caller's stack so that
+/// generating the moves of a position doesn't allocate.
+class MoveList {
+public:
+  /// No position has more moves: a hive of 18 tiles has at most 40 cells
+  /// around it, that is 200 placements, and the moving pieces add less than
+  /// that on top.
+  static constexpr std::size_t CAPACITY = 512;
+
+  void push_back(Move move) {
+    if (count == CAPACITY) {
+      throw std::length_error("Move list is full");
+    }
+    moves[count++] = move;
+  }
+
+  void clear() { count = 0; }
+
+  [[nodiscard]] std::size_t size() const { return count; }
+  [[nodiscard]] bool empty() const { return count == 0; }
+
+  [[nodiscard]] Move operator[](std::size_t idx) const { return moves[idx]; }
+
+  [[nodiscard]] const Move *begin() const { return moves.data(); }
+  [[nodiscard]] const Move *end() const { return moves.data() + count; }
+
+private:
+  // left uninitialized on purpose, only the first `count` moves are valid
+  std::array<Move, CAPACITY> moves;
+  std::size_t count = 0;
+};
+
+} // namespace hive
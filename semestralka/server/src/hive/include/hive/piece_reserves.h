@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <hive/types.h>
+
+namespace hive {
+
+/// Pieces both players have yet to place, a 4-bit counter for every player
+/// and kind packed into a single word. Checking, updating, copying and
+/// comparing the counters is a couple of instructions.
+class PieceReserves {
+public:
+  /// Pieces of every kind a player starts with, indexed by `PieceKind`.
+  static constexpr std::array<std::uint8_t, NUMBER_OF_PIECES> INITIAL{
+      1, // queen
+      2, // spiders
+      2, // beetles
+      2, // grasshoppers
+      2, // ants
+  };
+
+  constexpr PieceReserves() = default;
+
+  [[nodiscard]] constexpr std::size_t
+  count(Player player, PieceKind kind) const {
+    return (bits >> shift(player, kind)) & COUNTER_MASK;
+  }
+
+  [[nodiscard]] constexpr bool contains(Player player, PieceKind kind) const {
+    return count(player, kind) != 0;
+  }
+
+  /// Take a piece out of the reserve, which must contain it.
+  constexpr void take(Player player, PieceKind kind) {
+    bits -= Word{1} << shift(player, kind);
+  }
+
+  /// Return a piece taken by `take`.
+  constexpr void put_back(Player player, PieceKind kind) {
+    bits += Word{1} << shift(player, kind);
+  }
+
+  /// Whether `player` hasn't placed any piece yet.
+  [[nodiscard]] constexpr bool is_full(Player player) const {
+    return ((bits >> player_shift(player)) & PLAYER_MASK) == INITIAL_PLAYER;
+  }
+
+  /// Counters of `player` as a map, for callers that list them.
+  [[nodiscard]] PlayerPiecesMap to_map(Player player) const {
+    PlayerPiecesMap result;
+    for (std::size_t kind = 0; kind < NUMBER_OF_PIECES; ++kind) {
+      const auto piece_kind = static_cast<PieceKind>(kind);
+      result.emplace(piece_kind, count(player, piece_kind));
+    }
+    return result;
+  }
+
+  bool operator==(const PieceReserves &other) const = default;
+
+private:
+  using Word = std::uint64_t;
+
+  static constexpr std::size_t COUNTER_BITS = 4;
+  static constexpr Word COUNTER_MASK = (Word{1} << COUNTER_BITS) - 1;
+  /// Every player gets half of the word.
+  static constexpr std::size_t PLAYER_BITS = 32;
+  static constexpr Word PLAYER_MASK = (Word{1} << PLAYER_BITS) - 1;
+
+  static constexpr std::size_t player_shift(Player player) {
+    return static_cast<std::size_t>(player) * PLAYER_BITS;
+  }
+
+  static constexpr std::size_t shift(Player player, PieceKind kind) {
+    return player_shift(player) +
+           (static_cast<std::size_t>(kind) * COUNTER_BITS);
+  }
+
+  static constexpr Word INITIAL_PLAYER = [] {
+    Word counters = 0;
+    for (std::size_t kind = 0; kind < NUMBER_OF_PIECES; ++kind) {
+      counters |= Word{INITIAL[kind]} << (kind * COUNTER_BITS);
+    }
+    return counters;
+  }();
+
+  Word bits = INITIAL_PLAYER | (INITIAL_PLAYER << PLAYER_BITS);
+};
+
+static_assert(PieceReserves{}.count(Player::White, PieceKind::Queen) == 1);
+static_assert(PieceReserves{}.count(Player::Black, PieceKind::Ant) == 2);
+static_assert(PieceReserves{}.is_full(Player::Black));
+
+} // namespace hive
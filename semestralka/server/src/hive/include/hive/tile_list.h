@@ -0,0 +1,48 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <hive/types.h>
+#include <stdexcept>
+
+namespace hive {
+
+/// Unordered set of tile positions with a small fixed capacity, used for the
+/// tiles topped by the pieces of one player.
+class TileList {
+public:
+  /// Every player has nine pieces, so no player tops more tiles than that.
+  static constexpr std::size_t CAPACITY = 9;
+
+  void push_back(TilePointer ptr) {
+    if (count == CAPACITY) {
+      throw std::length_error("Tile list is full");
+    }
+    tiles[count++] = ptr;
+  }
+
+  /// Remove `ptr` by moving the last tile into its place, so the order of the
+  /// other tiles is not preserved.
+  void erase(TilePointer ptr) {
+    const auto *it = std::find(begin(), end(), ptr);
+    if (it == end()) {
+      throw std::out_of_range("Tile is not in the list");
+    }
+    tiles[static_cast<std::size_t>(it - begin())] = tiles[--count];
+  }
+
+  [[nodiscard]] std::size_t size() const { return count; }
+  [[nodiscard]] bool empty() const { return count == 0; }
+
+  [[nodiscard]] const TilePointer *begin() const { return tiles.data(); }
+  [[nodiscard]] const TilePointer *end() const {
+    return tiles.data() + count;
+  }
+
+private:
+  std::array<TilePointer, CAPACITY> tiles{};
+  std::size_t count = 0;
+};
+
+} // namespace hive
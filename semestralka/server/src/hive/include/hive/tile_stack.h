@@ -0,0 +1,65 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <hive/types.h>
+#include <stdexcept>
+
+namespace hive {
+
+/// Pieces on one tile from the bottom up, stored inline so that changing a
+/// tile never allocates and copying a board is a plain copy of its memory.
+class TileStack {
+public:
+  /// The piece at the bottom and all four beetles climbing on top of it.
+  static constexpr std::size_t CAPACITY = 5;
+
+  void push_back(Piece piece) {
+    if (height == CAPACITY) {
+      throw std::length_error("Tile stack is full");
+    }
+    pieces[height++] = piece;
+  }
+
+  void pop_back() { --height; }
+
+  [[nodiscard]] Piece back() const { return pieces[height - 1]; }
+
+  [[nodiscard]] std::size_t size() const { return height; }
+  [[nodiscard]] bool empty() const { return height == 0; }
+
+  [[nodiscard]] Piece operator[](std::size_t idx) const { return pieces[idx]; }
+
+  [[nodiscard]] const Piece *begin() const { return pieces.data(); }
+  [[nodiscard]] const Piece *end() const { return pieces.data() + height; }
+
+  bool operator==(const TileStack &other) const {
+    return std::equal(begin(), end(), other.begin(), other.end());
+  }
+
+private:
+  std::array<Piece, CAPACITY> pieces{};
+  std::uint8_t height = 0;
+};
+
+} // namespace hive
+
+template <> struct std::formatter<hive::TileStack> {
+  static constexpr auto parse(std::format_parse_context &ctx) {
+    return ctx.begin();
+  }
+
+  static auto format(const hive::TileStack &obj, std::format_context &ctx) {
+    std::format_to(ctx.out(), "[");
+    for (std::size_t i = 0; i < obj.size(); ++i) {
+      if (i != 0) {
+        std::format_to(ctx.out(), ", ");
+      }
+      std::format_to(ctx.out(), "{}", obj[i]);
+    }
+    return std::format_to(ctx.out(), "]");
+  }
+};
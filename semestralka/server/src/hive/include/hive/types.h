@@ -9,6 +9,10 @@
 namespace hive {
 
 enum class Player : std::uint8_t { Black, White };
+
+constexpr Player opponent(Player player) {
+  return player == Player::White ? Player::Black : Player::White;
+}
 enum class PieceKind : std::uint8_t { Queen, Spider, Beetle, Grasshopper, Ant };
 constexpr std::size_t NUMBER_OF_PIECES = 5;
 
@@ -46,6 +50,10 @@ inline Move make_placement(TilePointer pos, PieceKind piece_kind) {
 
 using PlayerPiecesMap = std::map<PieceKind, size_t>;
 
+/// State of a game, a player whose queen is surrounded on all six sides
+/// loses and surrounding both queens at once is a draw.
+enum class GameResult : std::uint8_t { InProgress, WhiteWon, BlackWon, Draw };
+
 using Direction = std::pair<Coordinate, Coordinate>;
 
 constexpr std::array<Direction, 6> DIRECTIONS{
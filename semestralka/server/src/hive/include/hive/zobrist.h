@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <hive/types.h>
+
+namespace hive::zobrist {
+
+using Key = std::uint64_t;
+
+/// SplitMix64 finalizer, a cheap bijective mix of all 64 bits.
+constexpr Key mix(Key value) {
+  value += 0x9e3779b97f4a7c15ULL;
+  value = (value ^ (value >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+  value = (value ^ (value >> 27U)) * 0x94d049bb133111ebULL;
+  return value ^ (value >> 31U);
+}
+
+/// Key of `piece` lying at `height` (0 for the bottom of the stack) of the
+/// tile at `ptr`.
+///
+/// The board is unbounded, so instead of a table of random numbers the keys
+/// are derived from the coordinates by a mixing function. They are the same
+/// in every process, so hashes can be stored on disk.
+constexpr Key piece(TilePointer ptr, std::size_t height, Piece piece) {
+  const auto p = static_cast<std::uint32_t>(ptr.p);
+  const auto q = static_cast<std::uint32_t>(ptr.q);
+  const auto kind = static_cast<std::uint32_t>(piece.kind);
+  const auto owner = static_cast<std::uint32_t>(piece.owner);
+
+  // 24 bits per coordinate is far more than a game can ever drift
+  const Key packed = (Key{p & 0xffffffU} << 40U) |
+                     (Key{q & 0xffffffU} << 16U) |
+                     (Key{static_cast<std::uint8_t>(height)} << 8U) |
+                     (kind << 1U) | owner;
+
+  return mix(packed);
+}
+
+/// Toggled into the hash of positions where white is to move.
+constexpr Key WHITE_TO_MOVE = mix(~Key{0});
+
+} // namespace hive::zobrist
@@ -1,9 +1,9 @@
 #include <algorithm>
+#include <cstdlib>
 #include <generator>
 #include <hive/board.h>
-#include <queue>
+#include <optional>
 #include <ranges>
-#include <stack>
 #include <unordered_set>
 #include <utility>
 
@@ -15,6 +15,40 @@ std::generator<TilePointer> neighboring_cells(TilePointer ptr) {
     co_yield {.p = ptr.p + p, .q = ptr.q + q};
   }
 }
+
+bool adjacent(TilePointer lhs, TilePointer rhs) {
+  const auto dp = lhs.p - rhs.p;
+  const auto dq = lhs.q - rhs.q;
+  return std::abs(dp) + std::abs(dq) + std::abs(dp + dq) == 2;
+}
+
+/// Index into `DIRECTIONS` of the straight line from `from` that goes through
+/// `to`, if there is one.
+std::optional<std::size_t> line_direction(TilePointer from, TilePointer to) {
+  const auto dp = to.p - from.p;
+  const auto dq = to.q - from.q;
+
+  for (std::size_t dir = 0; dir < DIRECTIONS.size(); ++dir) {
+    const auto [p, q] = DIRECTIONS[dir];
+    // parallel to the direction and pointing the same way
+    if (dp * q == dq * p && (dp * p) + (dq * q) > 0) {
+      return dir;
+    }
+  }
+  return std::nullopt;
+}
+
+/// Run `generate` with a visitor collecting into a `MoveList` and yield the
+/// collected moves, so the board is left alone while the caller iterates.
+template <typename Generate>
+std::generator<Move> collect_moves(Generate generate) {
+  MoveList moves;
+  generate([&moves](Move move) { moves.push_back(move); });
+
+  for (const auto move : moves) {
+    co_yield move;
+  }
+}
 } // namespace
 
 std::generator<TilePointer> Board::empty_neighbors(TilePointer ptr) const {
@@ -38,365 +72,484 @@ bool Board::tile_belongs_to_player(TilePointer ptr, Player player) const {
 }
 
 bool Board::neighbors_only_players(TilePointer ptr, Player player) const {
-  return std::ranges::all_of(
-      neighbors(ptr), [player, this](TilePointer neighbor) {
-        return tile_belongs_to_player(neighbor, player);
-      }
-  );
+  return !data.contains(ptr) ||
+         layers.neighbor_count(opponent(player), data.index(ptr)) == 0;
 }
 
 std::unordered_set<TilePointer> Board::tiles_around_hive() const {
   std::unordered_set<TilePointer> tiles;
+  tiles.reserve(layers.frontier.count());
 
-  for (const auto &[pos, tile] : data) {
-    if (tile.empty()) {
-      continue;
-    }
-
-    for (auto neighbor_ptr : empty_neighbors(pos)) {
-      tiles.insert(neighbor_ptr);
-    }
-  }
+  layers.frontier.for_each([&](grid::Index idx) {
+    tiles.insert(data.pointer(idx));
+  });
 
   return tiles;
 }
 
 bool Board::can_player_place_at(Player player, TilePointer ptr) const {
-  return is_empty(ptr) &&
-         (!has_placed(player) || neighbors_only_players(ptr, player));
+  // the first piece of the game goes where the move generator puts it
+  if (is_empty()) {
+    return ptr == FIRST_PLACEMENT;
+  }
+
+  return data.contains(ptr) && placement_cells(player).test(data.index(ptr));
 }
 
-std::generator<TilePointer> Board::valid_placements(Player player) const {
-  for (const auto &ptr : tiles_around_hive()) {
-    if (neighbors_only_players(ptr, player)) {
-      co_yield ptr;
-    }
+Bitboard Board::placement_cells(Player player) const {
+  // the first piece of a player is placed next to the opponent's one
+  if (!has_placed(player)) {
+    return layers.frontier;
   }
-}
 
-std::generator<Move> Board::moves_for_piece(TilePointer pos, Piece piece) {
-  constexpr std::array<
-      std::generator<Move> (hive::Board::*)(TilePointer),
-      NUMBER_OF_PIECES>
-      PIECE_HANDLERS{
-          &Board::queens_moves,
-          &Board::spider_moves,
-          &Board::beetle_moves,
-          &Board::grasshopper_moves,
-          &Board::ant_moves
-      };
-
-  const auto &handler =
-      PIECE_HANDLERS.at(static_cast<std::uint8_t>(piece.kind));
-
-  for (const auto piece_move : (this->*handler)(pos)) {
-    co_yield piece_move;
-  }
-}
-
-std::generator<Move>
-Board::moves_for_player(Player player, PlayerPiecesMap pieces) {
-  for (const auto placement_ptr : valid_placements(player)) {
-    for (const auto [piece_kind, count] : pieces) {
-      if (count == 0) {
-        continue;
-      }
+  return layers.frontier & ~layers.touching_of(opponent(player));
+}
 
-      co_yield {
-          .from = placement_ptr, .to = placement_ptr, .piece_kind = piece_kind
-      };
-    }
+std::generator<TilePointer> Board::valid_placements(Player player) const {
+  if (is_empty()) {
+    co_yield FIRST_PLACEMENT;
+    co_return;
   }
 
-  if (has_placed_queen(player)) {
-    for (const auto [pos, piece] : moveable_pieces_for(player)) {
-      for (const auto piece_move : moves_for_piece(pos, piece)) {
-        co_yield piece_move;
-      }
-    }
+  auto cells = placement_cells(player);
+
+  while (cells.any()) {
+    const auto idx = cells.first();
+    cells.reset(idx);
+
+    co_yield data.pointer(idx);
   }
 }
 
+std::generator<Move> Board::moves_for_piece(TilePointer pos, Piece piece) {
+  return collect_moves([this, pos, piece](auto &&visit) {
+    for_each_piece_move(pos, piece, visit);
+  });
+}
+
+std::generator<Move> Board::moves_for_player(Player player) {
+  return collect_moves([this, player](auto &&visit) {
+    for_each_player_move(player, visit);
+  });
+}
+
 std::generator<std::pair<TilePointer, Piece>> Board::pieces() const {
-  for (const auto &[pos, tile] : data) {
-    if (tile.empty()) {
-      continue;
+  for (const auto player : {Player::Black, Player::White}) {
+    for (auto &&tile : players_tiles(player)) {
+      co_yield tile;
     }
-
-    co_yield {pos, tile.back()};
   }
 }
 
 std::generator<std::pair<TilePointer, Piece>>
 Board::players_tiles(Player player) const {
-  for (const auto &[pos, tile] : data) {
-    if (tile.empty() || tile.back().owner != player) {
-      continue;
-    }
+  // the caller may change the board between the tiles, which reorders the
+  // list, so walk a copy of it
+  const auto tiles = top_tiles[static_cast<std::uint8_t>(player)];
 
-    co_yield {pos, tile.back()};
+  for (const auto ptr : tiles) {
+    co_yield {ptr, data[data.index(ptr)].back()};
   }
 }
 
 void Board::add_piece(TilePointer ptr, Piece piece) {
-  const auto [it, _] = data.emplace(ptr, std::vector<Piece>{});
-  it->second.push_back(piece);
+  if (data.reserve(ptr)) {
+    rebuild_layers();
+  }
+
+  const auto idx = data.index(ptr);
+  auto &tile = data[idx];
+  if (tile.empty()) {
+    ++tile_count;
+    count_queen_neighbors(ptr, 1);
+  } else {
+    top_tiles[static_cast<std::uint8_t>(tile.back().owner)].erase(ptr);
+  }
+  tile.push_back(piece);
+  top_tiles[static_cast<std::uint8_t>(piece.owner)].push_back(ptr);
+
+  if (piece.kind == PieceKind::Queen) {
+    const auto side = static_cast<std::uint8_t>(piece.owner);
+    queens[side] = ptr;
+    queen_neighbor_counts[side] = 0;
+    for (const auto &[p, q] : DIRECTIONS) {
+      if (!is_empty(TilePointer{.p = ptr.p + p, .q = ptr.q + q})) {
+        ++queen_neighbor_counts[side];
+      }
+    }
+  }
+  key ^= zobrist::piece(ptr, tile.size() - 1, piece);
+
+  layers.update(idx, tile);
+  pinned_valid = false;
+
+  if (listener != nullptr) {
+    listener->piece_added(ptr, piece);
+  }
 }
 
 Piece Board::remove_piece(TilePointer ptr) {
-  const auto it = data.find(ptr);
-  if (it == data.end() || it->second.empty()) {
+  if (is_empty(ptr)) {
     throw std::runtime_error("Tried to remove piece from empty tile");
   }
 
-  auto &[_, pieces] = *it;
-  const auto piece = pieces.back();
-  pieces.pop_back();
+  const auto idx = data.index(ptr);
+  auto &tile = data[idx];
+  const auto piece = tile.back();
+  key ^= zobrist::piece(ptr, tile.size() - 1, piece);
+  tile.pop_back();
 
-  return piece;
-}
-
-bool Board::moving_breaks_hive(TilePointer ptr) {
-  if (data.size() <= 2) {
-    return true;
+  top_tiles[static_cast<std::uint8_t>(piece.owner)].erase(ptr);
+  if (!tile.empty()) {
+    top_tiles[static_cast<std::uint8_t>(tile.back().owner)].push_back(ptr);
   }
 
-  const auto &tile = get(ptr);
+  if (piece.kind == PieceKind::Queen) {
+    const auto side = static_cast<std::uint8_t>(piece.owner);
+    queens[side] = std::nullopt;
+    queen_neighbor_counts[side] = 0;
+  }
 
-  if (tile.size() > 1) {
-    return false;
+  if (tile.empty()) {
+    --tile_count;
+    count_queen_neighbors(ptr, -1);
   }
 
-  const LiftPiece _(ptr, this);
+  layers.update(idx, tile);
+  pinned_valid = false;
+
+  if (listener != nullptr) {
+    listener->piece_removed(ptr, piece);
+  }
 
-  std::unordered_set<TilePointer> visited{};
-  std::stack<TilePointer> stack{};
+  return piece;
+}
 
-  // start from one of the neighbors
-  for (const auto neighbor_ptr : neighbors(ptr)) {
-    stack.push(neighbor_ptr);
-    break;
+Board::UndoInfo Board::make_move(Move move, Player player) {
+  const UndoInfo undo{
+      .move = move,
+      .player = player,
+      .origin = data.origin(),
+      .pinned = pinned,
+      .pinned_valid = pinned_valid
+  };
+
+  if (move.from == move.to) {
+    add_piece(move.to, Piece{.kind = move.piece_kind, .owner = player});
+    reserves.take(player, move.piece_kind);
+  } else {
+    add_piece(move.to, remove_piece(move.from));
   }
 
-  while (!stack.empty()) {
-    const auto current = stack.top();
-    stack.pop();
+  return undo;
+}
 
-    if (visited.contains(current)) {
-      continue;
-    }
-    visited.insert(current);
+void Board::unmake_move(const UndoInfo &undo) {
+  const auto move = undo.move;
 
-    for (const auto neighbor_ptr : neighbors(current)) {
-      stack.push(neighbor_ptr);
-    }
+  if (move.from == move.to) {
+    remove_piece(move.to);
+    reserves.put_back(undo.player, move.piece_kind);
+  } else {
+    add_piece(move.from, remove_piece(move.to));
   }
 
-  return std::ranges::any_of(
-      pieces() | std::ranges::views::keys,
-      [&visited](const auto ptr) { return !visited.contains(ptr); }
-  );
+  // the saved pinned tiles are only meaningful if the grid wasn't re-centered
+  // in the meantime
+  if (data.origin() == undo.origin) {
+    pinned = undo.pinned;
+    pinned_valid = undo.pinned_valid;
+  }
 }
 
-std::generator<std::pair<TilePointer, Piece>>
-Board::moveable_pieces_for(Player player) {
-  for (const auto [pos, piece] : players_tiles(player)) {
-    if (can_player_move(player, pos)) {
-      continue;
-    }
-
-    co_yield {pos, piece};
+void Board::rebuild_layers() {
+  layers = {};
+  for (std::size_t idx = 0; idx < grid::SIZE; ++idx) {
+    layers.update(static_cast<grid::Index>(idx), data[idx]);
   }
 }
 
-bool Board::can_move_to(
-    TilePointer from, TilePointer to, bool can_leave
-) const {
-  const auto [p, q] = from;
-  const auto [np, nq] = to;
+void Board::count_queen_neighbors(TilePointer ptr, int delta) {
+  for (std::size_t side = 0; side < queens.size(); ++side) {
+    if (queens[side] && adjacent(*queens[side], ptr)) {
+      queen_neighbor_counts[side] =
+          static_cast<std::uint8_t>(queen_neighbor_counts[side] + delta);
+    }
+  }
+}
 
-  const auto dir = std::make_pair(np - p, nq - q);
+bool Board::moving_breaks_hive(TilePointer ptr) const {
+  return data.contains(ptr) && pinned_tiles().test(data.index(ptr));
+}
 
-  const auto [lp, lq] = rotate_left(dir);
-  const auto [rp, rq] = rotate_right(dir);
+bool Board::is_legal(Move move, Player player) {
+  if (move.from == move.to) {
+    return reserves.contains(player, move.piece_kind) &&
+           can_player_place_at(player, move.to);
+  }
 
-  const TilePointer left{.p = p + lp, .q = q + lq};
-  const TilePointer right{.p = p + rp, .q = q + rq};
+  if (!has_placed_queen(player) || !data.contains(move.from) ||
+      !data.contains(move.to)) {
+    return false;
+  }
 
-  const auto left_empty = is_empty(left);
-  const auto right_empty = is_empty(right);
+  const auto start = data.index(move.from);
+  const auto target = data.index(move.to);
+  const auto &tile = data[start];
 
-  const bool has_gap = left_empty != right_empty;
-  const bool both_empty_and_can_leave = left_empty && right_empty && can_leave;
-  const bool has_neighbor_in_to_dir = has_neighbor_in_direction(to, dir);
+  if (tile.empty() ||
+      tile.back() != Piece{.kind = move.piece_kind, .owner = player} ||
+      pinned_tiles().test(start)) {
+    return false;
+  }
 
-  return has_gap || (both_empty_and_can_leave && has_neighbor_in_to_dir);
-}
+  const std::size_t neighbors =
+      layers.neighbor_count(Player::White, target) +
+      layers.neighbor_count(Player::Black, target);
 
-std::generator<TilePointer>
-Board::valid_steps(TilePointer ptr, bool can_leave) const {
-  for (const auto neighbor : empty_neighbors(ptr)) {
-    if (can_move_to(ptr, neighbor, can_leave)) {
-      co_yield neighbor;
+  switch (move.piece_kind) {
+  case PieceKind::Queen: {
+    if (!adjacent(move.from, move.to)) {
+      return false;
     }
+
+    // the same rules as `for_each_queen_move`, with the queen in place
+    const auto bit = 1U << *line_direction(move.from, move.to);
+    const auto gates = grid::SLIDE_GATES[layers.occupancy[start]];
+    return (gates.slides & bit) != 0 ||
+           ((gates.detached & bit) != 0 && neighbors > 1);
   }
-}
 
-bool Board::has_neighbor_in_direction(
-    TilePointer cell, Direction direction
-) const {
-  const auto [p, q] = cell;
-  const auto [dp, dq] = direction;
+  case PieceKind::Beetle: {
+    // lifting the beetle empties its tile unless it climbed on something
+    const std::size_t lifted = tile.size() == 1 ? 1 : 0;
+    return adjacent(move.from, move.to) && neighbors > lifted;
+  }
 
-  const auto [lp, lq] = rotate_left(direction);
-  const auto [rp, rq] = rotate_right(direction);
+  case PieceKind::Grasshopper: {
+    const auto dir = line_direction(move.from, move.to);
+    if (!dir) {
+      return false;
+    }
 
-  const TilePointer left{.p = p + lp, .q = q + lq};
-  const TilePointer right{.p = p + rp, .q = q + rq};
-  const TilePointer center{.p = p + dp, .q = q + dq};
+    auto current = grid::neighbor(start, *dir);
+    if (is_empty(current)) {
+      return false;
+    }
 
-  return !is_empty(left) || !is_empty(right) || !is_empty(center);
-}
+    while (current != target && !is_empty(current)) {
+      current = grid::neighbor(current, *dir);
+    }
+    return current == target && is_empty(target);
+  }
 
-bool Board::has_neighbor(TilePointer cell) const {
-  return data.size() == 2 ||
-         std::ranges::any_of(neighboring_cells(cell), [this](TilePointer ptr) {
-           return !is_empty(ptr);
-         });
-}
+  case PieceKind::Spider: {
+    // three slides never get further than three cells
+    const auto dp = move.to.p - move.from.p;
+    const auto dq = move.to.q - move.from.q;
+    if (std::abs(dp) + std::abs(dq) + std::abs(dp + dq) > 6) {
+      return false;
+    }
 
-std::generator<Move> Board::grasshopper_moves(TilePointer grasshopper) {
-  const LiftPiece _(grasshopper, this);
-
-  // for each direction
-  for (const auto [dp, dq] : DIRECTIONS) {
-    // start at grasshopper's position
-    auto current = grasshopper;
-    bool skipped = false;
-
-    // move in that direction until edge of board
-    while (true) {
-      current = {.p = current.p + dp, .q = current.q + dq};
-
-      // if tile is empty and
-      // if something was skipped, yield move
-      // else try different direction
-      if (is_empty(current)) {
-        if (skipped) {
-          co_yield Move{
-              .from = grasshopper,
-              .to = current,
-              .piece_kind = PieceKind::Grasshopper
-          };
-        }
-        break;
-      }
+    const LiftSlider _(start, &layers);
+    return spider_reaches(start, target);
+  }
 
-      skipped = true;
-    }
+  case PieceKind::Ant: {
+    const LiftSlider _(start, &layers);
+    return slide_reach(start, target).test(target);
+  }
   }
-}
 
-std::generator<Move> Board::queens_moves(TilePointer queen) {
-  const LiftPiece _(queen, this);
+  return false;
+}
 
-  for (const auto step_ptr : valid_steps(queen, true)) {
-    co_yield Move{
-        .from = queen, .to = step_ptr, .piece_kind = PieceKind::Queen
-    };
+const Bitboard &Board::pinned_tiles() const {
+  if (!pinned_valid) {
+    // a hive of two tiles is never split up, so both of them stay
+    pinned = tile_count <= 2 ? layers.occupied
+                             : articulation_points() & ~layers.stacked;
+    pinned_valid = true;
   }
+
+  return pinned;
 }
 
-std::generator<Move> Board::beetle_moves(TilePointer beetle) {
-  const LiftPiece _(beetle, this);
+Bitboard Board::articulation_points() const {
+  // iterative Tarjan's algorithm over the occupied tiles, `order` is the DFS
+  // discovery time and `low` the lowest discovery time reachable from the
+  // subtree through a single back edge
+  struct Frame {
+    grid::Index idx;
+    std::uint8_t dir;
+    std::uint8_t children;
+  };
 
-  for (const auto ptr : neighboring_cells(beetle)) {
-    if (has_neighbor(ptr)) {
-      co_yield Move{.from = beetle, .to = ptr, .piece_kind = PieceKind::Beetle};
-    }
+  Bitboard result;
+
+  if (tile_count == 0) {
+    return result;
   }
-}
 
-std::generator<Move> Board::spider_moves(TilePointer spider) {
-  const LiftPiece _(spider, this);
+  std::array<grid::Index, grid::SIZE> order;
+  std::array<grid::Index, grid::SIZE> low;
+  std::array<Frame, grid::SIZE> stack;
+
+  layers.occupied.for_each([&order](grid::Index idx) { order[idx] = 0; });
+
+  const auto root = layers.occupied.first();
+  grid::Index time = 0;
+  order[root] = low[root] = ++time;
 
-  std::unordered_set<TilePointer> visited;
-  std::vector<TilePointer> stack;
-  stack.push_back(spider);
+  std::size_t depth = 0;
+  stack[depth++] = {.idx = root, .dir = 0, .children = 0};
 
-  // do 3 steps
-  for (size_t i = 0; i < 3; ++i) {
-    std::vector<TilePointer> new_stack;
+  while (depth > 0) {
+    auto &frame = stack[depth - 1];
 
-    for (const auto ptr : stack) {
-      visited.insert(ptr);
+    if (frame.dir < DIRECTIONS.size()) {
+      const auto next = grid::neighbor(frame.idx, frame.dir++);
+      if (is_empty(next)) {
+        continue;
+      }
 
-      for (const auto step_ptr : valid_steps(ptr)) {
-        if (!visited.contains(step_ptr)) {
-          new_stack.push_back(step_ptr);
-        }
+      if (order[next] == 0) {
+        order[next] = low[next] = ++time;
+        ++frame.children;
+        stack[depth++] = {.idx = next, .dir = 0, .children = 0};
+      } else {
+        // the edge to the DFS parent is included as well, it doesn't affect
+        // articulation points, only bridges
+        low[frame.idx] = std::min(low[frame.idx], order[next]);
       }
+      continue;
     }
 
-    if (new_stack.empty()) {
+    --depth;
+    if (depth == 0) {
       break;
     }
 
-    stack = std::move(new_stack);
+    const auto parent = stack[depth - 1].idx;
+    low[parent] = std::min(low[parent], low[frame.idx]);
+
+    // the root is handled separately below
+    if (depth > 1 && low[frame.idx] >= order[parent]) {
+      result.set(parent);
+    }
   }
 
-  for (const auto ptr : stack) {
-    co_yield Move{.from = spider, .to = ptr, .piece_kind = PieceKind::Spider};
+  if (stack[0].children > 1) {
+    result.set(root);
   }
-}
 
-std::generator<Move> Board::ant_moves(TilePointer ant) {
-  const LiftPiece _(ant, this);
+  // tiles not reached from the root mean the hive is already split, moving
+  // anything keeps it split
+  if (static_cast<std::size_t>(time) != tile_count) {
+    return layers.occupied;
+  }
 
-  std::unordered_set<TilePointer> visited{ant};
-  std::queue<TilePointer> queue;
+  return result;
+}
 
-  // Add initial neighbors to queue
-  for (const auto neighbor : valid_steps(ant)) {
-    queue.push(neighbor);
+std::generator<std::pair<TilePointer, Piece>>
+Board::moveable_pieces_for(Player player) {
+  if (!has_placed_queen(player)) {
+    co_return;
   }
 
-  while (!queue.empty()) {
-    const auto current = queue.front();
-    queue.pop();
+  // generating moves of a piece lifts it, which invalidates the cache
+  const auto pinned_now = pinned_tiles();
 
-    if (visited.contains(current)) {
+  for (const auto [pos, piece] : players_tiles(player)) {
+    if (pinned_now.test(data.index(pos))) {
       continue;
     }
-    visited.insert(current);
 
-    co_yield Move{.from = ant, .to = current, .piece_kind = PieceKind::Ant};
+    co_yield {pos, piece};
+  }
+}
 
-    // Add next level neighbors
-    for (const auto neighbor : valid_steps(current)) {
-      queue.push(neighbor);
-    }
+Bitboard Board::slide_reach(
+    grid::Index start, std::optional<grid::Index> until
+) const {
+  // depth-first walk of the slide graph, every cell is pushed at most once
+  std::array<grid::Index, grid::SIZE> pending;
+  std::size_t count = 0;
+
+  auto reached = Bitboard::single(start);
+  pending[count++] = start;
+
+  while (count > 0 && !(until && reached.test(*until))) {
+    const auto cell = pending[--count];
+    detail::for_each_direction(layers.slides(cell), [&](std::size_t dir) {
+      const auto next = grid::neighbor(cell, dir);
+      if (!reached.test(next)) {
+        reached.set(next);
+        pending[count++] = next;
+      }
+    });
   }
+
+  reached.reset(start);
+  return reached;
+}
+
+bool Board::spider_reaches(grid::Index start, grid::Index target) const {
+  // the paths of `for_each_spider_move`, stopping at the first one that ends
+  // at `target`
+  return detail::any_direction(layers.slides(start), [&](std::size_t first) {
+    const auto one = grid::neighbor(start, first);
+    if (one == target) {
+      return false;
+    }
+
+    return detail::any_direction(layers.slides(one), [&](std::size_t second) {
+      const auto two = grid::neighbor(one, second);
+      if (two == start) {
+        return false;
+      }
+
+      return detail::any_direction(layers.slides(two), [&](std::size_t third) {
+        return grid::neighbor(two, third) == target;
+      });
+    });
+  });
+}
+
+bool Board::has_neighbor(grid::Index cell) const {
+  return layers.neighbor_count(Player::White, cell) != 0 ||
+         layers.neighbor_count(Player::Black, cell) != 0;
 }
 
-const PlayerPiecesMap Board::DEFAULT_PLAYER_PIECES = {
-    {PieceKind::Queen, 1},
-    {PieceKind::Grasshopper, 2},
-    {PieceKind::Beetle, 2},
-    {PieceKind::Spider, 2},
-    {PieceKind::Ant, 2},
-};
+std::generator<Move> Board::grasshopper_moves(TilePointer grasshopper) {
+  return collect_moves([this, grasshopper](auto &&visit) {
+    generate<PieceKind::Grasshopper>(grasshopper, visit);
+  });
+}
 
-bool Board::can_player_place(Player player, PieceKind kind) const {
-  return player_pieces.at(player).at(kind) > 0;
-};
+std::generator<Move> Board::queens_moves(TilePointer queen) {
+  return collect_moves([this, queen](auto &&visit) {
+    generate<PieceKind::Queen>(queen, visit);
+  });
+}
 
-bool Board::has_placed_queen(Player player) const {
-  return player_pieces.at(player).at(PieceKind::Queen) == 0;
+std::generator<Move> Board::beetle_moves(TilePointer beetle) {
+  return collect_moves([this, beetle](auto &&visit) {
+    generate<PieceKind::Beetle>(beetle, visit);
+  });
 }
 
-bool Board::has_placed(Player player) const {
-  return player_pieces.at(player) != DEFAULT_PLAYER_PIECES;
+std::generator<Move> Board::spider_moves(TilePointer spider) {
+  return collect_moves([this, spider](auto &&visit) {
+    generate<PieceKind::Spider>(spider, visit);
+  });
+}
+
+std::generator<Move> Board::ant_moves(TilePointer ant) {
+  return collect_moves([this, ant](auto &&visit) {
+    generate<PieceKind::Ant>(ant, visit);
+  });
 }
 
 } // namespace hive
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <hive/board.h>
+#include <hive/types.h>
+
+/// Counts the changes reported for a board, from any thread.
+class CountingListener : public hive::BoardListener {
+public:
+  std::atomic<std::size_t> changes{0};
+
+  void piece_added(hive::TilePointer /*ptr*/, hive::Piece /*piece*/) override {
+    ++changes;
+  }
+
+  void
+  piece_removed(hive::TilePointer /*ptr*/, hive::Piece /*piece*/) override {
+    ++changes;
+  }
+};
@@ -0,0 +1,67 @@
+#include "positions.h"
+#include <algorithm>
+#include <engine/evaluation.h>
+#include <engine/mcts.h>
+#include <gtest/gtest.h>
+#include <hive/board.h>
+#include <hive/move_list.h>
+#include <hive/types.h>
+
+class MctsTest : public ::testing::Test {
+protected:
+  void SetUp() override {};
+
+  void TearDown() override {};
+};
+
+namespace {
+
+using hive::Player;
+using positions::almost_surrounded;
+
+} // namespace
+
+TEST_F(MctsTest, FindsSurroundingMove) {
+  const auto board = almost_surrounded();
+
+  const hive::engine::HeuristicEvaluator evaluator;
+  hive::engine::Mcts mcts(evaluator, {.playouts = 2'000});
+
+  const auto result = mcts.run(board, Player::White);
+
+  ASSERT_TRUE(result.best_move);
+  EXPECT_EQ(result.best_move->to, (hive::TilePointer{.p = 1, .q = -1}));
+  EXPECT_EQ(result.playouts, 2'000);
+  EXPECT_DOUBLE_EQ(result.win_rate, 1.0);
+}
+
+TEST_F(MctsTest, ParallelSearchPlaysLegalMove) {
+  auto board = almost_surrounded();
+
+  const hive::engine::HeuristicEvaluator evaluator;
+  hive::engine::Mcts mcts(
+      evaluator, {.playouts = 500, .threads = 4, .node_capacity = 4'096}
+  );
+
+  const auto result = mcts.run(board, Player::Black);
+  ASSERT_TRUE(result.best_move);
+  EXPECT_EQ(result.playouts, 500);
+
+  hive::MoveList moves;
+  board.moves_for_player(Player::Black, moves);
+  EXPECT_NE(std::ranges::find(moves, *result.best_move), moves.end());
+}
+
+TEST_F(MctsTest, SearchIsRepeatable) {
+  const auto board = almost_surrounded();
+
+  const hive::engine::HeuristicEvaluator evaluator;
+  hive::engine::Mcts mcts(evaluator, {.playouts = 500, .seed = 7});
+
+  const auto first = mcts.run(board, Player::Black);
+  const auto second = mcts.run(board, Player::Black);
+
+  ASSERT_TRUE(first.best_move);
+  EXPECT_EQ(first.best_move, second.best_move);
+  EXPECT_DOUBLE_EQ(first.win_rate, second.win_rate);
+}
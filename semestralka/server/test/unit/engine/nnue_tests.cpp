@@ -0,0 +1,140 @@
+#include <cstdint>
+#include <cstring>
+#include <engine/nnue.h>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <hive/board.h>
+#include <hive/move_list.h>
+#include <hive/types.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+class NnueTest : public ::testing::Test {
+protected:
+  void SetUp() override {};
+
+  void TearDown() override { std::filesystem::remove(path); };
+
+  std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "hive_nnue_tests.bin";
+
+  using Network = hive::engine::NnueNetwork;
+
+  /// Write a network whose weights are drawn by `weight(section)`, the
+  /// sections being the feature weights, the bias, the output weights and
+  /// the output bias.
+  template <typename Weight> void write_network(Weight weight) {
+    std::vector<char> bytes(Network::FILE_SIZE);
+
+    Network::FileHeader header{
+        .magic = Network::MAGIC,
+        .version = Network::VERSION,
+        .features = Network::FEATURES,
+        .hidden = Network::HIDDEN,
+        .reserved = {}
+    };
+    std::memcpy(bytes.data(), &header, sizeof(header));
+
+    auto *out = bytes.data() + sizeof(header);
+    const auto write = [&out](auto value) {
+      std::memcpy(out, &value, sizeof(value));
+      out += sizeof(value);
+    };
+
+    for (std::size_t i = 0; i < Network::FEATURES * Network::HIDDEN; ++i) {
+      write(static_cast<std::int16_t>(weight(0)));
+    }
+    for (std::size_t i = 0; i < Network::HIDDEN; ++i) {
+      write(static_cast<std::int16_t>(weight(1)));
+    }
+    for (std::size_t i = 0; i < 2 * Network::HIDDEN; ++i) {
+      write(static_cast<std::int8_t>(weight(2)));
+    }
+    write(static_cast<std::int32_t>(weight(3)));
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  }
+};
+
+using hive::PieceKind;
+using hive::Player;
+
+TEST_F(NnueTest, ClipsAccumulator) {
+  const auto evaluate_with_bias = [this](int bias) {
+    write_network([bias](int section) {
+      return section == 1 ? bias : section == 2 ? 1 : 0;
+    });
+
+    const hive::engine::NnueEvaluator evaluator(path);
+    return evaluator.evaluate(hive::Board{}, Player::White);
+  };
+
+  const auto hidden = static_cast<int>(Network::HIDDEN);
+  const auto divisor = Network::OUTPUT_DIVISOR;
+
+  EXPECT_EQ(evaluate_with_bias(10), 2 * hidden * 10 / divisor);
+  EXPECT_EQ(evaluate_with_bias(500), 2 * hidden * 127 / divisor);
+  EXPECT_EQ(evaluate_with_bias(-500), 0);
+}
+
+TEST_F(NnueTest, IncrementalMatchesScratch) {
+  std::mt19937 weights_rng(1);
+  write_network([&weights_rng](int section) {
+    std::uniform_int_distribution<int> weight(
+        section == 1 ? 0 : -30, section == 1 ? 60 : 30
+    );
+    return weight(weights_rng);
+  });
+
+  const hive::engine::NnueEvaluator evaluator(path);
+
+  hive::Board board;
+  const auto listener = evaluator.attach(board);
+  ASSERT_EQ(board.get_listener(), listener.get());
+
+  std::mt19937 rng(7);
+  std::vector<hive::Board::UndoInfo> undo;
+  auto player = Player::White;
+
+  for (std::size_t ply = 0; ply < 80; ++ply) {
+    // lifts every piece of the player for a moment
+    hive::MoveList moves;
+    board.moves_for_player(player, moves);
+
+    auto scratch = board;
+    scratch.set_listener(nullptr);
+    for (const auto side : {Player::White, Player::Black}) {
+      ASSERT_EQ(
+          evaluator.evaluate(board, side), evaluator.evaluate(scratch, side)
+      ) << "ply " << ply;
+    }
+
+    if (!undo.empty() && rng() % 4 == 0) {
+      board.unmake_move(undo.back());
+      undo.pop_back();
+    } else if (!moves.empty()) {
+      undo.push_back(board.make_move(moves[rng() % moves.size()], player));
+    }
+    player = hive::opponent(player);
+  }
+}
+
+TEST_F(NnueTest, RejectsMalformedFile) {
+  EXPECT_THROW(hive::engine::NnueEvaluator{path}, std::runtime_error);
+
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "HIVENNUE";
+  }
+  EXPECT_THROW(hive::engine::NnueEvaluator{path}, std::runtime_error);
+
+  write_network([](int /*section*/) { return 0; });
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file << "NOTHIVE!";
+  }
+  EXPECT_THROW(hive::engine::NnueEvaluator{path}, std::runtime_error);
+}
@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <engine/bot.h>
+#include <engine/opening_book.h>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <hive/board.h>
+#include <hive/types.h>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+class OpeningBookTest : public ::testing::Test {
+protected:
+  void SetUp() override {};
+
+  void TearDown() override { std::filesystem::remove(path); };
+
+  std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "hive_opening_book_tests.bin";
+};
+
+using hive::PieceKind;
+using hive::Player;
+
+namespace {
+
+hive::engine::BookEntry
+entry(hive::zobrist::Key key, hive::Move move, std::uint16_t weight) {
+  return *hive::engine::BookEntry::make(key, move, weight);
+}
+
+} // namespace
+
+TEST_F(OpeningBookTest, ProbeFindsEveryKey) {
+  std::mt19937_64 rng(3);
+  const auto move = hive::make_placement({.p = 1, .q = -1}, PieceKind::Ant);
+
+  std::vector<hive::engine::BookEntry> entries;
+  std::vector<hive::zobrist::Key> keys{
+      0, std::numeric_limits<hive::zobrist::Key>::max()
+  };
+  for (std::size_t i = 0; i < 10'000; ++i) {
+    keys.push_back(rng());
+  }
+
+  // every key gets one to three moves
+  for (const auto key : keys) {
+    for (std::uint16_t i = 0; i <= key % 3; ++i) {
+      entries.push_back(entry(key, move, i));
+    }
+  }
+  hive::engine::OpeningBook::write(path, entries);
+
+  const hive::engine::OpeningBook book(path);
+  EXPECT_EQ(book.size(), entries.size());
+
+  for (const auto key : keys) {
+    const auto found = book.probe(key);
+    ASSERT_EQ(found.size(), (key % 3) + 1) << key;
+    EXPECT_TRUE(std::ranges::all_of(found, [key](const auto &found_entry) {
+      return found_entry.key == key;
+    }));
+  }
+
+  for (std::size_t i = 0; i < 1'000; ++i) {
+    const auto key = rng();
+    if (std::ranges::find(keys, key) == keys.end()) {
+      EXPECT_TRUE(book.probe(key).empty());
+    }
+  }
+}
+
+TEST_F(OpeningBookTest, BotPlaysBookMove) {
+  const hive::Board board;
+  const auto key = board.hash(Player::White);
+
+  const auto ant = hive::make_placement({.p = 0, .q = 0}, PieceKind::Ant);
+  const auto spider =
+      hive::make_placement({.p = 0, .q = 0}, PieceKind::Spider);
+  hive::engine::OpeningBook::write(
+      path, {entry(key, ant, 5), entry(key, spider, 10)}
+  );
+
+  hive::engine::Bot bot(
+      {.limits = {.time_budget = std::chrono::milliseconds(50)},
+       .book = std::make_shared<const hive::engine::OpeningBook>(path)}
+  );
+
+  EXPECT_EQ(bot.choose_move(board, Player::White), spider);
+  // not in the book, the bot has to search
+  EXPECT_TRUE(bot.choose_move(board, Player::Black));
+}
+
+TEST_F(OpeningBookTest, BotIgnoresIllegalBookMove) {
+  const hive::Board board;
+  const auto far = hive::make_placement({.p = 5, .q = 5}, PieceKind::Ant);
+  hive::engine::OpeningBook::write(
+      path, {entry(board.hash(Player::White), far, 1)}
+  );
+
+  hive::engine::Bot bot(
+      {.limits = {.time_budget = std::chrono::milliseconds(50)},
+       .book = std::make_shared<const hive::engine::OpeningBook>(path)}
+  );
+
+  const auto move = bot.choose_move(board, Player::White);
+  ASSERT_TRUE(move);
+  EXPECT_NE(*move, far);
+}
+
+TEST_F(OpeningBookTest, RejectsMalformedFile) {
+  EXPECT_THROW(hive::engine::OpeningBook{path}, std::runtime_error);
+
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "HIVEBOOK";
+  }
+  EXPECT_THROW(hive::engine::OpeningBook{path}, std::runtime_error);
+
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "NOTABOOK" << std::string(24, '\0');
+  }
+  EXPECT_THROW(hive::engine::OpeningBook{path}, std::runtime_error);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <hive/board.h>
+#include <hive/types.h>
+
+namespace positions {
+
+/// Black queen with five neighbors, a white ant can fill the sixth one.
+inline hive::Board almost_surrounded() {
+  using hive::PieceKind;
+  using hive::Player;
+
+  hive::Board board;
+  const auto place = [&board](auto ptr, PieceKind kind, Player player) {
+    board.apply_move(hive::make_placement(ptr, kind), player);
+  };
+
+  place(hive::TilePointer{.p = 0, .q = 0}, PieceKind::Queen, Player::Black);
+  place(hive::TilePointer{.p = 1, .q = 0}, PieceKind::Spider, Player::White);
+  place(hive::TilePointer{.p = 0, .q = 1}, PieceKind::Ant, Player::Black);
+  place(
+      hive::TilePointer{.p = -1, .q = 1}, PieceKind::Grasshopper, Player::White
+  );
+  place(hive::TilePointer{.p = -1, .q = 0}, PieceKind::Beetle, Player::Black);
+  place(hive::TilePointer{.p = 0, .q = -1}, PieceKind::Spider, Player::Black);
+  place(hive::TilePointer{.p = -2, .q = 1}, PieceKind::Queen, Player::White);
+  place(hive::TilePointer{.p = 2, .q = 0}, PieceKind::Ant, Player::White);
+
+  return board;
+}
+
+} // namespace positions
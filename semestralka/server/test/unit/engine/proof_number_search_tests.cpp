@@ -0,0 +1,149 @@
+#include "counting_listener.h"
+#include "positions.h"
+#include <engine/proof_number_search.h>
+#include <gtest/gtest.h>
+#include <hive/board.h>
+#include <hive/move_list.h>
+#include <hive/types.h>
+#include <random>
+
+class ProofNumberSearchTest : public ::testing::Test {
+protected:
+  void SetUp() override {};
+
+  void TearDown() override {};
+};
+
+namespace {
+
+using hive::Player;
+using hive::engine::Proof;
+using positions::almost_surrounded;
+
+/// Whether `attacker` surrounds the other queen within `plies` by plain
+/// minimax, `player` being to move.
+bool forced_win(
+    hive::Board &board, Player player, Player attacker, std::size_t plies
+) {
+  const auto surrounded = [&board](Player side) {
+    return board.queen_neighbors(side) == hive::DIRECTIONS.size();
+  };
+  if (surrounded(attacker)) {
+    return false;
+  }
+  if (surrounded(hive::opponent(attacker))) {
+    return true;
+  }
+  if (plies == 0) {
+    return false;
+  }
+
+  hive::MoveList moves;
+  board.moves_for_player(player, moves);
+  if (moves.empty()) {
+    return forced_win(board, hive::opponent(player), attacker, plies - 1);
+  }
+
+  for (const auto move : moves) {
+    const auto undo = board.make_move(move, player);
+    const bool win =
+        forced_win(board, hive::opponent(player), attacker, plies - 1);
+    board.unmake_move(undo);
+
+    if (win == (player == attacker)) {
+      return win;
+    }
+  }
+  return player != attacker;
+}
+
+} // namespace
+
+TEST_F(ProofNumberSearchTest, ProvesSurroundingMove) {
+  hive::engine::ProofNumberSearch solver(1);
+
+  const auto result =
+      solver.solve(almost_surrounded(), Player::White, {.max_plies = 1});
+
+  EXPECT_EQ(result.proof, Proof::Win);
+  ASSERT_TRUE(result.move);
+  EXPECT_EQ(result.move->to, (hive::TilePointer{.p = 1, .q = -1}));
+}
+
+TEST_F(ProofNumberSearchTest, DisprovesWithoutPlies) {
+  hive::engine::ProofNumberSearch solver(1);
+
+  const auto result =
+      solver.solve(almost_surrounded(), Player::White, {.max_plies = 0});
+
+  EXPECT_EQ(result.proof, Proof::NoWin);
+  EXPECT_FALSE(result.move);
+}
+
+TEST_F(ProofNumberSearchTest, GivesUpAfterNodeLimit) {
+  hive::engine::ProofNumberSearch solver(1);
+
+  const auto result = solver.solve(
+      almost_surrounded(), Player::Black, {.max_plies = 5, .max_nodes = 10}
+  );
+
+  EXPECT_EQ(result.proof, Proof::Unknown);
+}
+
+TEST_F(ProofNumberSearchTest, MatchesMinimax) {
+  hive::engine::ProofNumberSearch solver(1);
+  std::mt19937 rng(5);
+
+  for (std::size_t game = 0; game < 3; ++game) {
+    auto board = almost_surrounded();
+    auto player = Player::White;
+
+    for (std::size_t ply = 0; ply < 6; ++ply) {
+      const auto result = solver.solve(board, player, {.max_plies = 3});
+      ASSERT_NE(result.proof, Proof::Unknown);
+      EXPECT_EQ(
+          result.proof == Proof::Win, forced_win(board, player, player, 3)
+      ) << "game " << game << " ply " << ply;
+
+      if (result.move) {
+        auto after = board;
+        after.apply_move(*result.move, player);
+        EXPECT_TRUE(forced_win(after, hive::opponent(player), player, 2));
+      }
+
+      hive::MoveList moves;
+      board.moves_for_player(player, moves);
+      if (moves.empty()) {
+        break;
+      }
+      board.apply_move(moves[rng() % moves.size()], player);
+      player = hive::opponent(player);
+    }
+  }
+}
+
+TEST_F(ProofNumberSearchTest, SolvesWithCollidingEntries) {
+  // a table of a single entry, every node evicts the previous one
+  hive::engine::ProofNumberSearch solver(0);
+  auto board = almost_surrounded();
+
+  for (const auto player : {Player::White, Player::Black}) {
+    const auto result = solver.solve(board, player, {.max_plies = 3});
+    ASSERT_NE(result.proof, Proof::Unknown);
+    EXPECT_EQ(result.proof == Proof::Win, forced_win(board, player, player, 3));
+  }
+}
+
+TEST_F(ProofNumberSearchTest, SolveLeavesCallersListenerAlone) {
+  auto board = almost_surrounded();
+  CountingListener listener;
+  board.set_listener(&listener);
+
+  // the solver plays its moves on a copy, which must not report to the
+  // listener of the board it was copied from
+  hive::engine::ProofNumberSearch solver(1);
+  const auto result = solver.solve(board, Player::White, {.max_plies = 3});
+
+  EXPECT_NE(result.proof, Proof::Unknown);
+  EXPECT_EQ(listener.changes, 0);
+}
@@ -0,0 +1,155 @@
+#include "counting_listener.h"
+#include "positions.h"
+#include <algorithm>
+#include <chrono>
+#include <engine/bot.h>
+#include <engine/evaluation.h>
+#include <engine/parallel_search.h>
+#include <engine/search.h>
+#include <engine/transposition_table.h>
+#include <gtest/gtest.h>
+#include <hive/board.h>
+#include <hive/move_list.h>
+#include <hive/types.h>
+
+class SearchTest : public ::testing::Test {
+protected:
+  void SetUp() override {};
+
+  void TearDown() override {};
+};
+
+namespace {
+
+using hive::PieceKind;
+using hive::Player;
+using positions::almost_surrounded;
+
+} // namespace
+
+TEST_F(SearchTest, FindsSurroundingMove) {
+  const auto board = almost_surrounded();
+  ASSERT_EQ(board.queen_neighbors(Player::Black), 5);
+
+  const hive::engine::HeuristicEvaluator evaluator;
+  hive::engine::TranspositionTable table(1);
+  hive::engine::Search search(evaluator, table);
+
+  const auto result = search.run(
+      board, Player::White, {.time_budget = std::chrono::seconds(10)}
+  );
+
+  ASSERT_TRUE(result.best_move);
+  EXPECT_EQ(result.best_move->to, (hive::TilePointer{.p = 1, .q = -1}));
+  EXPECT_GT(result.score, hive::engine::WIN_THRESHOLD);
+  EXPECT_EQ(result.depth, 1);
+}
+
+TEST_F(SearchTest, AvoidsLosingMove) {
+  const auto board = almost_surrounded();
+
+  // black to move has to keep the last cell next to its queen free
+  const hive::engine::HeuristicEvaluator evaluator;
+  hive::engine::TranspositionTable table(1);
+  hive::engine::Search search(evaluator, table);
+
+  const auto result = search.run(
+      board,
+      Player::Black,
+      {.time_budget = std::chrono::seconds(10), .max_depth = 2}
+  );
+
+  ASSERT_TRUE(result.best_move);
+  EXPECT_NE(result.best_move->to, (hive::TilePointer{.p = 1, .q = -1}));
+  EXPECT_GT(result.score, -hive::engine::WIN_THRESHOLD);
+  EXPECT_EQ(result.depth, 2);
+}
+
+TEST_F(SearchTest, BotPlaysLegalMoveWithinBudget) {
+  hive::Board board;
+  hive::engine::Bot bot(
+      {.limits = {.time_budget = std::chrono::milliseconds(50)}}
+  );
+
+  auto player = Player::White;
+  for (int ply = 0; ply < 8; ++ply) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto move = bot.choose_move(board, player);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_TRUE(move);
+    EXPECT_LT(elapsed, std::chrono::milliseconds(500));
+
+    hive::MoveList moves;
+    board.moves_for_player(player, moves);
+    EXPECT_NE(std::ranges::find(moves, *move), moves.end());
+
+    board.apply_move(*move, player);
+    player = hive::opponent(player);
+  }
+}
+
+TEST_F(SearchTest, ParallelSearchFindsSurroundingMove) {
+  const auto board = almost_surrounded();
+
+  const hive::engine::HeuristicEvaluator evaluator;
+  hive::engine::TranspositionTable table(1);
+  hive::engine::ParallelSearch search(evaluator, table, 4);
+
+  const auto result = search.run(
+      board,
+      Player::White,
+      {.time_budget = std::chrono::seconds(10), .max_depth = 3}
+  );
+
+  ASSERT_TRUE(result.best_move);
+  EXPECT_EQ(result.best_move->to, (hive::TilePointer{.p = 1, .q = -1}));
+  EXPECT_GT(result.score, hive::engine::WIN_THRESHOLD);
+}
+
+TEST_F(SearchTest, ParallelSearchStopsHelpers) {
+  hive::Board board;
+  board.apply_move(
+      hive::make_placement({.p = 0, .q = 0}, PieceKind::Queen), Player::White
+  );
+  board.apply_move(
+      hive::make_placement({.p = 1, .q = 0}, PieceKind::Queen), Player::Black
+  );
+
+  const hive::engine::HeuristicEvaluator evaluator;
+  hive::engine::TranspositionTable table(1);
+  hive::engine::ParallelSearch search(evaluator, table, 4);
+
+  // the main thread stops early, the helpers must not outlive it by much
+  const auto start = std::chrono::steady_clock::now();
+  const auto result = search.run(
+      board,
+      Player::White,
+      {.time_budget = std::chrono::seconds(30), .max_depth = 3}
+  );
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  EXPECT_TRUE(result.best_move);
+  EXPECT_GE(result.depth, 3);
+  EXPECT_LT(elapsed, std::chrono::seconds(5));
+}
+
+TEST_F(SearchTest, SearchLeavesCallersListenerAlone) {
+  auto board = almost_surrounded();
+  CountingListener listener;
+  board.set_listener(&listener);
+
+  // the copies searched by the threads must not report to the listener of
+  // the board they were copied from
+  const hive::engine::HeuristicEvaluator evaluator;
+  hive::engine::TranspositionTable table(1);
+  hive::engine::ParallelSearch search(evaluator, table, 4);
+  const auto result = search.run(
+      board,
+      Player::Black,
+      {.time_budget = std::chrono::seconds(10), .max_depth = 2}
+  );
+
+  EXPECT_TRUE(result.best_move);
+  EXPECT_EQ(listener.changes, 0);
+}
@@ -0,0 +1,100 @@
+#include <engine/transposition_table.h>
+#include <gtest/gtest.h>
+#include <hive/types.h>
+
+class TranspositionTableTest : public ::testing::Test {
+protected:
+  void SetUp() override {};
+
+  void TearDown() override {};
+};
+
+namespace {
+
+constexpr hive::Move MOVE{
+    .from = {.p = -3, .q = 7},
+    .to = {.p = 2, .q = -1},
+    .piece_kind = hive::PieceKind::Grasshopper
+};
+
+} // namespace
+
+TEST_F(TranspositionTableTest, StoreAndProbe) {
+  hive::engine::TranspositionTable table(1);
+  EXPECT_EQ(table.capacity(), (1U << 20U) / 64 * 4);
+
+  EXPECT_FALSE(table.probe(42));
+
+  table.store(
+      42,
+      {.move = MOVE,
+       .score = -1234,
+       .depth = 5,
+       .bound = hive::engine::Bound::Lower}
+  );
+
+  const auto entry = table.probe(42);
+  ASSERT_TRUE(entry);
+  EXPECT_EQ(entry->move, MOVE);
+  EXPECT_EQ(entry->score, -1234);
+  EXPECT_EQ(entry->depth, 5);
+  EXPECT_EQ(entry->bound, hive::engine::Bound::Lower);
+
+  // same bucket, different key
+  EXPECT_FALSE(table.probe(42 + (1U << 20U)));
+
+  table.clear();
+  EXPECT_FALSE(table.probe(42));
+}
+
+TEST_F(TranspositionTableTest, FarMovesAreDropped) {
+  hive::engine::TranspositionTable table(1);
+
+  const hive::Move far{
+      .from = {.p = 200, .q = 0},
+      .to = {.p = 201, .q = 0},
+      .piece_kind = hive::PieceKind::Queen
+  };
+  table.store(
+      7,
+      {.move = far,
+       .score = 10,
+       .depth = 1,
+       .bound = hive::engine::Bound::Exact}
+  );
+
+  const auto entry = table.probe(7);
+  ASSERT_TRUE(entry);
+  EXPECT_FALSE(entry->move);
+  EXPECT_EQ(entry->score, 10);
+}
+
+TEST_F(TranspositionTableTest, KeepsDeepEntries) {
+  hive::engine::TranspositionTable table(1);
+  const auto buckets = table.capacity() / 4;
+
+  // fill one bucket with entries of increasing depth
+  for (std::uint8_t i = 0; i < 4; ++i) {
+    table.store(
+        1 + (i * buckets),
+        {.move = std::nullopt,
+         .score = i,
+         .depth = static_cast<std::uint8_t>(10 + i),
+         .bound = hive::engine::Bound::Exact}
+    );
+  }
+
+  // the shallowest entry makes room for a new one
+  table.store(
+      1 + (4 * buckets),
+      {.move = std::nullopt,
+       .score = 0,
+       .depth = 1,
+       .bound = hive::engine::Bound::Exact}
+  );
+
+  EXPECT_FALSE(table.probe(1));
+  for (std::uint8_t i = 1; i <= 4; ++i) {
+    EXPECT_TRUE(table.probe(1 + (i * buckets)));
+  }
+}
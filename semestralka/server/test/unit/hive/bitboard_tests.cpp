@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+#include <hive/bitboard.h>
+
+class BitboardTest : public ::testing::Test {
+protected:
+  void SetUp() override {};
+
+  void TearDown() override {};
+};
+
+namespace {
+
+constexpr hive::grid::Index CENTER =
+    (hive::grid::WIDTH / 2 * hive::grid::WIDTH) + (hive::grid::WIDTH / 2);
+
+} // namespace
+
+TEST_F(BitboardTest, ShiftAcrossWords) {
+  const auto board = hive::Bitboard::single(63);
+
+  EXPECT_TRUE(board.shifted(1).test(64));
+  EXPECT_TRUE(board.shifted(hive::grid::WIDTH).test(63 + hive::grid::WIDTH));
+  EXPECT_TRUE(board.shifted(1).shifted(-1).test(63));
+  EXPECT_FALSE(board.shifted(-64).any());
+}
+
+TEST_F(BitboardTest, NeighborsMatchGrid) {
+  const auto neighbors = hive::Bitboard::single(CENTER).neighbors();
+
+  EXPECT_EQ(neighbors.count(), 6);
+  for (std::size_t dir = 0; dir < hive::DIRECTIONS.size(); ++dir) {
+    EXPECT_TRUE(neighbors.test(hive::grid::neighbor(CENTER, dir)));
+  }
+}
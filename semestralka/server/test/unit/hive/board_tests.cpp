@@ -0,0 +1,571 @@
+#include "hive/types.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <hive/board.h>
+#include <vector>
+
+class BoardTest : public ::testing::Test {
+protected:
+  void SetUp() override {};
+
+  void TearDown() override {};
+};
+
+namespace {
+
+constexpr hive::Piece WHITE_QUEEN{
+    .kind = hive::PieceKind::Queen, .owner = hive::Player::White
+};
+constexpr hive::Piece BLACK_QUEEN{
+    .kind = hive::PieceKind::Queen, .owner = hive::Player::Black
+};
+constexpr hive::Piece WHITE_ANT{
+    .kind = hive::PieceKind::Ant, .owner = hive::Player::White
+};
+constexpr hive::Piece BLACK_BEETLE{
+    .kind = hive::PieceKind::Beetle, .owner = hive::Player::Black
+};
+
+std::vector<hive::TilePointer> destinations(auto &&moves) {
+  std::vector<hive::TilePointer> result;
+  for (const auto move : moves) {
+    result.push_back(move.to);
+  }
+  std::ranges::sort(result, [](auto lhs, auto rhs) {
+    return std::pair(lhs.p, lhs.q) < std::pair(rhs.p, rhs.q);
+  });
+  return result;
+}
+
+using Tiles = std::vector<std::pair<hive::TilePointer, hive::TileStack>>;
+
+Tiles tiles(const hive::Board &board) {
+  Tiles result;
+  for (const auto &[ptr, _] : board.pieces()) {
+    result.emplace_back(ptr, board.get(ptr));
+  }
+  return result;
+}
+
+constexpr std::size_t direction_index(hive::Direction dir) {
+  return static_cast<std::size_t>(
+      std::ranges::find(hive::DIRECTIONS, dir) - hive::DIRECTIONS.begin()
+  );
+}
+
+/// Slide gates worked out step by step from the rotated direction vectors.
+constexpr bool slide_gates_match_rules() {
+  for (unsigned mask = 0; mask < hive::grid::SLIDE_GATES.size(); ++mask) {
+    const auto occupied = [mask](hive::Direction dir) {
+      return ((mask >> direction_index(dir)) & 1U) != 0;
+    };
+
+    unsigned slides = 0;
+    unsigned detached = 0;
+    for (std::size_t dir = 0; dir < hive::DIRECTIONS.size(); ++dir) {
+      const auto to = hive::DIRECTIONS[dir];
+      if (occupied(to)) {
+        continue;
+      }
+
+      const auto left = occupied(hive::rotate_left(to));
+      const auto right = occupied(hive::rotate_right(to));
+      if (left != right) {
+        slides |= 1U << dir;
+      } else if (!left) {
+        detached |= 1U << dir;
+      }
+    }
+
+    const auto gates = hive::grid::SLIDE_GATES[mask];
+    if (gates.slides != slides || gates.detached != detached) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(slide_gates_match_rules());
+
+} // namespace
+
+TEST_F(BoardTest, AddAndRemovePiece) {
+  hive::Board board;
+  const hive::TilePointer ptr{.p = 0, .q = 0};
+
+  EXPECT_TRUE(board.is_empty());
+  EXPECT_TRUE(board.is_empty(ptr));
+
+  board.add_piece(ptr, WHITE_QUEEN);
+  board.add_piece(ptr, BLACK_BEETLE);
+
+  EXPECT_FALSE(board.is_empty());
+  EXPECT_EQ(board.get(ptr).size(), 2);
+  EXPECT_EQ(board.get_top(ptr), BLACK_BEETLE);
+
+  EXPECT_EQ(board.remove_piece(ptr), BLACK_BEETLE);
+  EXPECT_EQ(board.remove_piece(ptr), WHITE_QUEEN);
+
+  EXPECT_TRUE(board.is_empty());
+  EXPECT_TRUE(board.is_empty(ptr));
+  EXPECT_THROW(board.remove_piece(ptr), std::runtime_error);
+}
+
+TEST_F(BoardTest, FarAwayTilesAreEmpty) {
+  hive::Board board;
+  board.add_piece({.p = 0, .q = 0}, WHITE_QUEEN);
+
+  EXPECT_TRUE(board.is_empty({.p = 1000, .q = -1000}));
+  EXPECT_THROW((void)board.get({.p = 1000, .q = -1000}), std::out_of_range);
+}
+
+TEST_F(BoardTest, HiveDriftKeepsPieces) {
+  hive::Board board;
+  board.add_piece({.p = 0, .q = 0}, WHITE_QUEEN);
+  board.add_piece({.p = 1, .q = 0}, BLACK_QUEEN);
+
+  // walk the pair far away from the starting position, which forces the
+  // board to re-center several times
+  for (hive::Coordinate p = 0; p < 100; ++p) {
+    const auto piece = board.remove_piece({.p = p, .q = 0});
+    board.add_piece({.p = p + 2, .q = 0}, piece);
+  }
+
+  EXPECT_EQ(board.get_top({.p = 100, .q = 0}), WHITE_QUEEN);
+  EXPECT_EQ(board.get_top({.p = 101, .q = 0}), BLACK_QUEEN);
+  EXPECT_TRUE(board.is_empty({.p = 0, .q = 0}));
+
+  EXPECT_EQ(std::ranges::distance(board.pieces()), 2);
+}
+
+TEST_F(BoardTest, AntWalksAroundHive) {
+  hive::Board board;
+  board.add_piece({.p = 0, .q = 0}, WHITE_QUEEN);
+  board.add_piece({.p = 1, .q = 0}, BLACK_QUEEN);
+  board.add_piece({.p = -1, .q = 0}, WHITE_ANT);
+
+  // every empty cell around the two queens
+  const std::vector<hive::TilePointer> expected{
+      {.p = -1, .q = 1},
+      {.p = 0, .q = -1},
+      {.p = 0, .q = 1},
+      {.p = 1, .q = -1},
+      {.p = 1, .q = 1},
+      {.p = 2, .q = -1},
+      {.p = 2, .q = 0},
+  };
+
+  EXPECT_EQ(destinations(board.ant_moves({.p = -1, .q = 0})), expected);
+}
+
+TEST_F(BoardTest, MovingBreaksHive) {
+  hive::Board board;
+  board.add_piece({.p = -1, .q = 0}, WHITE_ANT);
+  board.add_piece({.p = 0, .q = 0}, WHITE_QUEEN);
+  board.add_piece({.p = 1, .q = 0}, BLACK_QUEEN);
+
+  EXPECT_FALSE(board.moving_breaks_hive({.p = -1, .q = 0}));
+  EXPECT_TRUE(board.moving_breaks_hive({.p = 0, .q = 0}));
+  EXPECT_FALSE(board.moving_breaks_hive({.p = 1, .q = 0}));
+}
+
+TEST_F(BoardTest, MoveablePiecesSkipPinned) {
+  hive::Board board;
+  board.apply_move(
+      hive::make_placement({.p = 0, .q = 0}, hive::PieceKind::Queen),
+      hive::Player::White
+  );
+  board.apply_move(
+      hive::make_placement({.p = 1, .q = 0}, hive::PieceKind::Queen),
+      hive::Player::Black
+  );
+  board.apply_move(
+      hive::make_placement({.p = -1, .q = 0}, hive::PieceKind::Ant),
+      hive::Player::White
+  );
+
+  std::vector<hive::TilePointer> moveable;
+  for (const auto [ptr, _] : board.moveable_pieces_for(hive::Player::White)) {
+    moveable.push_back(ptr);
+  }
+
+  const std::vector<hive::TilePointer> expected{{.p = -1, .q = 0}};
+  EXPECT_EQ(moveable, expected);
+  EXPECT_TRUE(board.can_player_move(hive::Player::White, {.p = -1, .q = 0}));
+  EXPECT_FALSE(board.can_player_move(hive::Player::White, {.p = 0, .q = 0}));
+}
+
+TEST_F(BoardTest, SpiderMovesExactlyThreeSteps) {
+  hive::Board board;
+  board.add_piece({.p = 0, .q = 0}, WHITE_QUEEN);
+  board.add_piece({.p = 1, .q = 0}, BLACK_QUEEN);
+  board.add_piece(
+      {.p = -1, .q = 0},
+      {.kind = hive::PieceKind::Spider, .owner = hive::Player::White}
+  );
+
+  const std::vector<hive::TilePointer> expected{
+      {.p = 1, .q = 1},
+      {.p = 2, .q = -1},
+  };
+
+  EXPECT_EQ(destinations(board.spider_moves({.p = -1, .q = 0})), expected);
+}
+
+TEST_F(BoardTest, MoveListMatchesGenerator) {
+  hive::Board board;
+  board.apply_move(
+      hive::make_placement({.p = 0, .q = 0}, hive::PieceKind::Queen),
+      hive::Player::White
+  );
+  board.apply_move(
+      hive::make_placement({.p = 1, .q = 0}, hive::PieceKind::Queen),
+      hive::Player::Black
+  );
+  board.apply_move(
+      hive::make_placement({.p = -1, .q = 0}, hive::PieceKind::Ant),
+      hive::Player::White
+  );
+
+  std::vector<hive::Move> generated;
+  for (const auto move : board.moves_for_player(hive::Player::White)) {
+    generated.push_back(move);
+  }
+
+  hive::MoveList moves;
+  board.moves_for_player(hive::Player::White, moves);
+
+  EXPECT_FALSE(moves.empty());
+  EXPECT_EQ(std::vector<hive::Move>(moves.begin(), moves.end()), generated);
+}
+
+TEST_F(BoardTest, UnmakeMoveRestoresBoard) {
+  hive::Board board;
+  board.apply_move(
+      hive::make_placement({.p = 0, .q = 0}, hive::PieceKind::Queen),
+      hive::Player::White
+  );
+  board.apply_move(
+      hive::make_placement({.p = 1, .q = 0}, hive::PieceKind::Queen),
+      hive::Player::Black
+  );
+  board.apply_move(
+      hive::make_placement({.p = -1, .q = 0}, hive::PieceKind::Beetle),
+      hive::Player::White
+  );
+  board.apply_move(
+      hive::make_placement({.p = 2, .q = 0}, hive::PieceKind::Ant),
+      hive::Player::Black
+  );
+
+  const auto before = tiles(board);
+  const auto pieces_before = board.get_player_pieces();
+  const auto pinned_before = board.pinned_tiles();
+  const auto hash_before = board.hash();
+
+  for (const auto player : {hive::Player::White, hive::Player::Black}) {
+    hive::MoveList moves;
+    board.moves_for_player(player, moves);
+    ASSERT_FALSE(moves.empty());
+
+    for (const auto move : moves) {
+      const auto undo = board.make_move(move, player);
+      EXPECT_FALSE(board.is_empty(move.to));
+
+      board.unmake_move(undo);
+      EXPECT_EQ(tiles(board), before);
+      EXPECT_EQ(board.get_player_pieces(), pieces_before);
+      EXPECT_EQ(board.pinned_tiles(), pinned_before);
+      EXPECT_EQ(board.hash(), hash_before);
+    }
+  }
+}
+
+TEST_F(BoardTest, UnmakeMoveAfterRecentering) {
+  hive::Board board;
+  board.add_piece({.p = 0, .q = 0}, WHITE_QUEEN);
+  board.add_piece({.p = 1, .q = 0}, BLACK_QUEEN);
+
+  const auto before = tiles(board);
+
+  // far enough to force the grid to re-center
+  const auto undo = board.make_move(
+      hive::make_move(
+          {.p = 0, .q = 0}, {.p = 14, .q = 0}, hive::PieceKind::Queen
+      ),
+      hive::Player::White
+  );
+  board.unmake_move(undo);
+
+  EXPECT_EQ(tiles(board), before);
+  EXPECT_TRUE(board.moving_breaks_hive({.p = 0, .q = 0}));
+}
+
+TEST_F(BoardTest, HashIgnoresMoveOrder) {
+  hive::Board first;
+  first.add_piece({.p = 0, .q = 0}, WHITE_QUEEN);
+  first.add_piece({.p = 1, .q = 0}, BLACK_QUEEN);
+  first.add_piece({.p = -1, .q = 0}, WHITE_ANT);
+
+  hive::Board second;
+  second.add_piece({.p = 1, .q = 0}, BLACK_QUEEN);
+  second.add_piece({.p = 2, .q = 0}, WHITE_ANT);
+  second.add_piece({.p = 0, .q = 0}, WHITE_QUEEN);
+  // the ant reaches the same cell along a different path
+  second.add_piece({.p = -1, .q = 0}, second.remove_piece({.p = 2, .q = 0}));
+
+  EXPECT_NE(first.hash(), hive::Board{}.hash());
+  EXPECT_EQ(first.hash(), second.hash());
+  EXPECT_NE(first.hash(hive::Player::White), first.hash(hive::Player::Black));
+}
+
+TEST_F(BoardTest, HashDependsOnStackOrder) {
+  hive::Board first;
+  first.add_piece({.p = 0, .q = 0}, WHITE_QUEEN);
+  first.add_piece({.p = 0, .q = 0}, BLACK_BEETLE);
+
+  hive::Board second;
+  second.add_piece({.p = 0, .q = 0}, BLACK_BEETLE);
+  second.add_piece({.p = 0, .q = 0}, WHITE_QUEEN);
+
+  EXPECT_NE(first.hash(), second.hash());
+}
+
+TEST_F(BoardTest, OpeningPlacements) {
+  constexpr auto WHITE = hive::Player::White;
+  constexpr auto BLACK = hive::Player::Black;
+  hive::Board board;
+
+  hive::MoveList moves;
+  board.moves_for_player(WHITE, moves);
+  EXPECT_EQ(moves.size(), hive::NUMBER_OF_PIECES);
+  for (const auto move : moves) {
+    EXPECT_EQ(move.to, hive::Board::FIRST_PLACEMENT);
+  }
+
+  // the first piece goes only where the move generator puts it
+  for (const hive::TilePointer ptr :
+       {hive::Board::FIRST_PLACEMENT, hive::TilePointer{.p = 3, .q = 2}}) {
+    const auto move = hive::make_placement(ptr, hive::PieceKind::Spider);
+    EXPECT_EQ(
+        board.can_player_place_at(WHITE, ptr), board.is_legal(move, WHITE)
+    );
+  }
+  EXPECT_FALSE(board.can_player_place_at(WHITE, {.p = 3, .q = 2}));
+
+  board.apply_move(
+      hive::make_placement({.p = 0, .q = 0}, hive::PieceKind::Spider), WHITE
+  );
+
+  // the first black piece touches the white one
+  moves.clear();
+  board.moves_for_player(BLACK, moves);
+  EXPECT_EQ(moves.size(), 6 * hive::NUMBER_OF_PIECES);
+  EXPECT_TRUE(board.can_player_place_at(BLACK, {.p = 1, .q = 0}));
+  EXPECT_FALSE(board.can_player_place_at(BLACK, {.p = 2, .q = 0}));
+
+  board.apply_move(
+      hive::make_placement({.p = 1, .q = 0}, hive::PieceKind::Spider), BLACK
+  );
+
+  // from then on, pieces can't be placed next to the opponent
+  EXPECT_EQ(std::ranges::distance(board.valid_placements(WHITE)), 3);
+  EXPECT_FALSE(board.can_player_place_at(WHITE, {.p = 0, .q = 1}));
+}
+
+TEST_F(BoardTest, QueenNeighbors) {
+  hive::Board board;
+  EXPECT_EQ(board.queen_neighbors(hive::Player::White), 0);
+
+  board.add_piece({.p = 0, .q = 0}, WHITE_QUEEN);
+  board.add_piece({.p = 1, .q = 0}, BLACK_QUEEN);
+  board.add_piece({.p = 0, .q = 1}, WHITE_ANT);
+
+  EXPECT_EQ(board.queen_neighbors(hive::Player::White), 2);
+  EXPECT_EQ(board.queen_neighbors(hive::Player::Black), 2);
+
+  // a beetle on top doesn't hide the queen
+  board.add_piece({.p = 0, .q = 0}, BLACK_BEETLE);
+  EXPECT_EQ(board.queen_neighbors(hive::Player::White), 2);
+}
+
+TEST_F(BoardTest, GameResult) {
+  hive::Board board;
+  board.add_piece({.p = 0, .q = 0}, WHITE_QUEEN);
+  EXPECT_EQ(board.game_result(), hive::GameResult::InProgress);
+
+  // black queen at (1, 0), the rest fills the other neighbors of (0, 0)
+  board.add_piece({.p = 1, .q = 0}, BLACK_QUEEN);
+  for (const auto ptr : std::vector<hive::TilePointer>{
+           {.p = 0, .q = 1},
+           {.p = -1, .q = 1},
+           {.p = -1, .q = 0},
+           {.p = 0, .q = -1},
+       }) {
+    board.add_piece(ptr, WHITE_ANT);
+  }
+  EXPECT_EQ(board.game_result(), hive::GameResult::InProgress);
+
+  board.add_piece({.p = 1, .q = -1}, BLACK_BEETLE);
+  EXPECT_EQ(board.queen_neighbors(hive::Player::White), 6);
+  EXPECT_EQ(board.game_result(), hive::GameResult::BlackWon);
+
+  // surround the black queen as well, its neighbors so far are (0, 0),
+  // (0, 1) and (1, -1)
+  for (const auto ptr : std::vector<hive::TilePointer>{
+           {.p = 2, .q = 0},
+           {.p = 2, .q = -1},
+           {.p = 1, .q = 1},
+       }) {
+    board.add_piece(ptr, WHITE_ANT);
+  }
+  EXPECT_EQ(board.queen_neighbors(hive::Player::Black), 6);
+  EXPECT_EQ(board.game_result(), hive::GameResult::Draw);
+
+  // a beetle climbing off keeps the cell below occupied
+  board.add_piece({.p = 1, .q = -1}, BLACK_BEETLE);
+  board.remove_piece({.p = 1, .q = -1});
+  EXPECT_EQ(board.game_result(), hive::GameResult::Draw);
+
+  board.remove_piece({.p = 1, .q = -1});
+  EXPECT_EQ(board.queen_neighbors(hive::Player::White), 5);
+  EXPECT_EQ(board.game_result(), hive::GameResult::InProgress);
+
+  // moving the queen recounts its neighbors
+  board.remove_piece({.p = 1, .q = 0});
+  EXPECT_EQ(board.queen_neighbors(hive::Player::Black), 0);
+  EXPECT_EQ(board.queen_neighbors(hive::Player::White), 4);
+  board.add_piece({.p = 1, .q = -1}, BLACK_QUEEN);
+  EXPECT_EQ(board.queen_neighbors(hive::Player::Black), 3);
+  EXPECT_EQ(board.queen_neighbors(hive::Player::White), 5);
+}
+
+TEST_F(BoardTest, QueenNeighborsFollowMoves) {
+  hive::Board board;
+  auto player = hive::Player::White;
+  std::vector<hive::Board::UndoInfo> undo;
+
+  // compare with counting the neighbors of the queens from scratch
+  const auto counted = [&board](hive::Player side) {
+    for (const auto &[ptr, top] : board.pieces()) {
+      const hive::Piece queen{.kind = hive::PieceKind::Queen, .owner = side};
+      if (std::ranges::find(board.get(ptr), queen) != board.get(ptr).end()) {
+        return static_cast<std::size_t>(
+            std::ranges::distance(board.neighbors(ptr))
+        );
+      }
+    }
+    return std::size_t{0};
+  };
+
+  for (std::size_t ply = 0; ply < 200; ++ply) {
+    hive::MoveList moves;
+    board.moves_for_player(player, moves);
+
+    for (const auto side : {hive::Player::White, hive::Player::Black}) {
+      ASSERT_EQ(board.queen_neighbors(side), counted(side)) << "ply " << ply;
+    }
+
+    if (!undo.empty() && ply % 5 == 0) {
+      board.unmake_move(undo.back());
+      undo.pop_back();
+    } else if (!moves.empty()) {
+      const auto move = moves[(ply * 7919) % moves.size()];
+      undo.push_back(board.make_move(move, player));
+    }
+    player = hive::opponent(player);
+  }
+}
+
+TEST_F(BoardTest, LayersFollowMoves) {
+  hive::Board board;
+  auto player = hive::Player::White;
+  std::vector<hive::Board::UndoInfo> undo;
+
+  for (std::size_t ply = 0; ply < 200; ++ply) {
+    hive::MoveList moves;
+    board.moves_for_player(player, moves);
+
+    const auto &layers = board.get_layers();
+    ASSERT_EQ(layers.frontier, layers.occupied.neighbors()) << "ply " << ply;
+    layers.frontier.for_each([&](hive::grid::Index cell) {
+      std::uint8_t occupancy = 0;
+      for (std::size_t dir = 0; dir < hive::DIRECTIONS.size(); ++dir) {
+        if (layers.occupied.test(hive::grid::neighbor(cell, dir))) {
+          occupancy |= static_cast<std::uint8_t>(1U << dir);
+        }
+      }
+      ASSERT_EQ(layers.occupancy[cell], occupancy) << "ply " << ply;
+    });
+
+    for (const auto side : {hive::Player::White, hive::Player::Black}) {
+      hive::Bitboard touching;
+      for (std::size_t dir = 0; dir < hive::DIRECTIONS.size(); ++dir) {
+        touching |= layers.of(side).step(dir);
+      }
+      ASSERT_EQ(layers.touching_of(side), touching) << "ply " << ply;
+
+      std::size_t tiles = 0;
+      for (const auto &[ptr, top] : board.players_tiles(side)) {
+        ASSERT_EQ(board.get_top(ptr), top) << "ply " << ply;
+        ASSERT_EQ(top.owner, side) << "ply " << ply;
+        ++tiles;
+      }
+      ASSERT_EQ(tiles, layers.of(side).count()) << "ply " << ply;
+    }
+
+    if (!undo.empty() && ply % 7 == 0) {
+      board.unmake_move(undo.back());
+      undo.pop_back();
+    } else if (!moves.empty()) {
+      const auto move = moves[(ply * 104729) % moves.size()];
+      undo.push_back(board.make_move(move, player));
+    }
+    player = hive::opponent(player);
+  }
+}
+
+TEST_F(BoardTest, IsLegalMatchesGenerator) {
+  constexpr hive::Coordinate RADIUS = 10;
+
+  hive::Board board;
+  auto player = hive::Player::White;
+
+  for (std::size_t ply = 0; ply < 150; ++ply) {
+    hive::MoveList moves;
+    board.moves_for_player(player, moves);
+
+    for (const auto move : moves) {
+      ASSERT_TRUE(board.is_legal(move, player)) << "ply " << ply;
+    }
+
+    // every placement and every move of any piece to a cell near the hive
+    std::vector<hive::Move> candidates;
+    for (hive::Coordinate p = -RADIUS; p <= RADIUS; ++p) {
+      for (hive::Coordinate q = -RADIUS; q <= RADIUS; ++q) {
+        const hive::TilePointer to{.p = p, .q = q};
+        for (std::size_t kind = 0; kind < hive::NUMBER_OF_PIECES; ++kind) {
+          candidates.push_back(
+              hive::make_placement(to, static_cast<hive::PieceKind>(kind))
+          );
+        }
+        for (const auto &[from, top] : board.pieces()) {
+          candidates.push_back(hive::make_move(from, to, top.kind));
+        }
+      }
+    }
+
+    for (const auto candidate : candidates) {
+      ASSERT_EQ(
+          board.is_legal(candidate, player),
+          std::ranges::find(moves, candidate) != moves.end()
+      ) << "ply " << ply << " move " << std::format("{}", candidate);
+    }
+
+    if (moves.empty()) {
+      break;
+    }
+    board.apply_move(moves[(ply * 7919) % moves.size()], player);
+    player = hive::opponent(player);
+  }
+}